@@ -1 +1,77 @@
-#include "CancellationToken.h"  // Ϊ·// ʵѾͷļ
\ No newline at end of file
+#include "CancellationToken.h"  // Ϊ·
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace {
+
+// һߴڴأallocate_shared ÿĶǡƿ + ơͬһС
+class TokenBlockPool {
+public:
+    TokenBlockPool() { free_.reserve(kMaxFree); }
+
+    void* Allocate(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (bytes == blockSize_ && !free_.empty()) {
+                void* p = free_.back();
+                free_.pop_back();
+                return p;
+            }
+            if (blockSize_ == 0) blockSize_ = bytes;
+        }
+        return ::operator new(bytes);
+    }
+
+    void Free(void* p, size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (bytes == blockSize_ && free_.size() < kMaxFree) {
+                free_.push_back(p);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static constexpr size_t kMaxFree = 4096;
+    std::mutex mtx_;
+    size_t blockSize_ = 0;
+    std::vector<void*> free_;
+};
+
+// ⲻ˳ʱԿ̬
+TokenBlockPool& Pool() {
+    static TokenBlockPool* pool = new TokenBlockPool();
+    return *pool;
+}
+
+template <class T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned token block");
+        return static_cast<T*>(Pool().Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        Pool().Free(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <class U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+}  // namespace
+
+CancellationTokenPtr CancellationTokenPool::Acquire() {
+    return std::allocate_shared<CancellationToken>(PoolAllocator<CancellationToken>());
+}
\ No newline at end of file
@@ -1,15 +1,82 @@
 #pragma once
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 class CancellationToken {
 public:
-    void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    using CallbackId = uint64_t;
+
+    // һȡʱεעĻصڵ Cancel ߳ϣ
+    void Cancel() {
+        if (cancelled_.exchange(true, std::memory_order_acq_rel)) return;
+
+        std::vector<std::pair<CallbackId, std::function<void()>>> callbacks;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            callbacks.swap(callbacks_);
+        }
+        cv_.notify_all();
+        for (auto& cb : callbacks) cb.second();
+    }
+
     bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
-    void Reset() { cancelled_.store(false, std::memory_order_relaxed); }
+
+    void Reset() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        callbacks_.clear();
+        cancelled_.store(false, std::memory_order_relaxed);
+    }
+
+    // ڴ I/Oȡʱò 0
+    CallbackId Register(std::function<void()> cb) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (!cancelled_.load(std::memory_order_acquire)) {
+                CallbackId id = ++nextId_;
+                callbacks_.emplace_back(id, std::move(cb));
+                return id;
+            }
+        }
+        cb();
+        return 0;
+    }
+
+    void Unregister(CallbackId id) {
+        if (id == 0) return;
+        std::lock_guard<std::mutex> lk(mtx_);
+        for (auto it = callbacks_.begin(); it != callbacks_.end(); ++it) {
+            if (it->first == id) {
+                callbacks_.erase(it);
+                return;
+            }
+        }
+    }
+
+    //  sleep_forȡʱ true
+    template <class Rep, class Period>
+    bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        return cv_.wait_for(lk, timeout, [&]() { return cancelled_.load(std::memory_order_acquire); });
+    }
 
 private:
     std::atomic<bool> cancelled_{ false };
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    CallbackId nextId_ = 0;
+    std::vector<std::pair<CallbackId, std::function<void()>>> callbacks_;
 };
 
-using CancellationTokenPtr = std::shared_ptr<CancellationToken>;
\ No newline at end of file
+using CancellationTokenPtr = std::shared_ptr<CancellationToken>;
+
+// ƳأƺͿƿڻյڴύ·ٷڴ
+class CancellationTokenPool {
+public:
+    static CancellationTokenPtr Acquire();
+};
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "CoroutineTask.h"
+#include "TaskScheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// һιĻָڣʱI/O ɡȡ˭ȵ˭ָָֻһ
+struct ResumeGate {
+    std::mutex mtx;  // 𷽵Ǽ֮ǰָЭҪ
+    std::atomic<bool> fired{ false };
+    TaskScheduler* scheduler = nullptr;
+    TaskStatePtr state;  // ڼ״̬
+    CancellationToken::CallbackId cancelCb = 0;
+
+    void Fire() {
+        if (fired.exchange(true)) return;
+        scheduler->Resume(std::move(state));
+    }
+};
+
+TaskResult CoroutineTask::Run(const CancellationTokenPtr& token) {
+    Body body = RunAsync(token);
+    Handle h = body.Get();
+    h.promise().token = token;
+
+    // ûеʱȴڵǰ߳һ resume ͻִе
+    h.resume();
+
+    auto& promise = h.promise();
+    if (promise.error) {
+        std::rethrow_exception(promise.error);
+    }
+    return std::move(promise.result);
+}
+
+void CoroutineTask::FinalAwaiter::await_suspend(Handle h) noexcept {
+    auto& promise = h.promise();
+    if (!promise.scheduler) return;  // ִͬУ Run ȡ
+
+    // Э֡ TaskState ٣ֻϱ
+    if (auto state = promise.state.lock()) {
+        promise.scheduler->CompleteCoroutine(state, std::move(promise.result), promise.error);
+    }
+}
+
+bool Delay::await_suspend(CoroutineTask::Handle h) {
+    auto& promise = h.promise();
+    token_ = promise.token;
+    if (token_ && token_->IsCancelled()) return false;
+
+    if (!promise.scheduler) {
+        if (token_) token_->WaitFor(duration_);
+        else std::this_thread::sleep_for(duration_);
+        return false;
+    }
+
+    auto gate = std::make_shared<ResumeGate>();
+    gate->scheduler = promise.scheduler;
+    gate->state = promise.state.lock();
+    if (!gate->state) return false;
+    gate_ = gate;
+
+    // ￪ʼЭָֻ̻ܷ̿߳ʾֲ gate
+    std::lock_guard<std::mutex> lk(gate->mtx);
+    auto timer = gate->scheduler->AddTimer(TaskScheduler::Clock::now() + duration_,
+        [gate]() { gate->Fire(); }, TaskScheduler::Clock::duration::zero(), MissedPeriodPolicy::Skip);
+    if (timer == TimerWheel::kInvalidTimer) {
+        // ֹͣȴԶᵽڣ𲢰ȡǵѾ
+        gate->fired = true;
+        gate->state.reset();
+        stopped_ = true;
+        if (token_) token_->Cancel();
+        return false;
+    }
+    if (token_) {
+        gate->cancelCb = token_->Register([gate]() { gate->Fire(); });
+    }
+    return true;
+}
+
+void Delay::await_resume() {
+    if (gate_) {
+        std::lock_guard<std::mutex> lk(gate_->mtx);
+        // ȵʱȡصϣȡʱʱںֻǿղ
+        if (token_) token_->Unregister(gate_->cancelCb);
+    }
+    gate_.reset();
+
+    if (stopped_ || (token_ && token_->IsCancelled())) {
+        throw TaskCancelledError();
+    }
+}
+
+bool AwaitIo::await_suspend(CoroutineTask::Handle h) {
+    auto& promise = h.promise();
+    token_ = promise.token;
+    if (token_ && token_->IsCancelled()) return false;
+
+    if (!promise.scheduler) {
+        // ִͬУڵǰ̵߳ȴɻȡ
+        struct Signal {
+            std::mutex mtx;
+            std::condition_variable cv;
+            bool done = false;
+        };
+        auto sig = std::make_shared<Signal>();
+        auto wake = [sig]() {
+            {
+                std::lock_guard<std::mutex> lk(sig->mtx);
+                sig->done = true;
+            }
+            sig->cv.notify_all();
+        };
+        auto cancelCb = token_ ? token_->Register(wake) : 0;
+        start_(wake);
+        {
+            std::unique_lock<std::mutex> lk(sig->mtx);
+            sig->cv.wait(lk, [&]() { return sig->done; });
+        }
+        if (token_) token_->Unregister(cancelCb);
+        return false;
+    }
+
+    auto gate = std::make_shared<ResumeGate>();
+    gate->scheduler = promise.scheduler;
+    gate->state = promise.state.lock();
+    if (!gate->state) return false;
+    gate_ = gate;
+
+    std::lock_guard<std::mutex> lk(gate->mtx);
+    if (token_) {
+        gate->cancelCb = token_->Register([gate]() { gate->Fire(); });
+    }
+    try {
+        start_([gate]() { gate->Fire(); });
+    }
+    catch (...) {
+        // ʧܣٻָ쳣Э
+        if (!gate->fired.exchange(true)) {
+            gate->state.reset();
+            if (token_) token_->Unregister(gate->cancelCb);
+            throw;
+        }
+        // ȡѾ˻ָ쳣ֻܶ
+    }
+    return true;
+}
+
+void AwaitIo::await_resume() {
+    if (gate_) {
+        std::lock_guard<std::mutex> lk(gate_->mtx);
+        if (token_) token_->Unregister(gate_->cancelCb);
+    }
+    gate_.reset();
+
+    if (token_ && token_->IsCancelled()) {
+        throw TaskCancelledError();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "ITask.h"
+#include "TaskHandle.h"
+
+class TaskScheduler;
+
+// 㷢ȡʱ co_await ׳
+class TaskCancelledError : public std::runtime_error {
+public:
+    TaskCancelledError() : std::runtime_error("Task cancelled at suspension point") {}
+};
+
+// ЭRunAsync  co_await Delay / AwaitIo ọ́߳
+// ȴ⹤߳ϼִ
+class CoroutineTask : public ITask {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // RunAsync ķֵδʼЭ
+    class Body {
+    public:
+        using promise_type = CoroutineTask::promise_type;
+
+        explicit Body(Handle h) : h_(h) {}
+        Body(Body&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+        Body(const Body&) = delete;
+        Body& operator=(const Body&) = delete;
+        ~Body() { if (h_) h_.destroy(); }
+
+        Handle Get() const { return h_; }
+        Handle Release() { return std::exchange(h_, {}); }
+
+    private:
+        Handle h_;
+    };
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Handle h) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        TaskScheduler* scheduler = nullptr;  // ΪձʾִͬУֱӵ Run
+        std::weak_ptr<TaskState> state;
+        CancellationTokenPtr token;
+        TaskResult result;
+        std::exception_ptr error;
+
+        Body get_return_object() { return Body(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_value(TaskResult r) { result = std::move(r); }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    virtual Body RunAsync(CancellationTokenPtr token) = 0;
+
+    // ʱ͵ִЭ
+    std::string Execute(const CancellationTokenPtr& token) final {
+        return Run(token).payload;
+    }
+    TaskResult Run(const CancellationTokenPtr& token) final;
+};
+
+struct ResumeGate;
+
+// co_await Delay(duration)ʱֵںָȡʱָ׳ TaskCancelledError
+class Delay {
+public:
+    explicit Delay(std::chrono::steady_clock::duration duration) : duration_(duration) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(CoroutineTask::Handle h);
+    void await_resume();
+
+private:
+    std::chrono::steady_clock::duration duration_;
+    CancellationTokenPtr token_;
+    std::shared_ptr<ResumeGate> gate_;
+    bool stopped_ = false;  // ֹͣûܹ
+};
+
+// co_await AwaitIo(start)װصʽ첽 I/O
+// start յһɻصI/O ʱ̵߳ɻָЭ
+class AwaitIo {
+public:
+    using Completion = std::function<void()>;
+
+    explicit AwaitIo(std::function<void(Completion)> start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(CoroutineTask::Handle h);
+    void await_resume();
+
+private:
+    std::function<void(Completion)> start_;
+    CancellationTokenPtr token_;
+    std::shared_ptr<ResumeGate> gate_;
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "EventBatcher.h"
+#include "EventBus.h"
+
+// ¼ߺŶӵ¼ϢλߺܳϢ
+static_assert(MessagePool::kSlots >= EventBusOptions{}.capacity + EventBatcherOptions{}.capacity,
+    "MessagePool must hold every message referenced by queued events");
+
+EventBatcher::EventBatcher(IEventBatchSink& sink, const EventBatcherOptions& options)
+    : sink_(sink), options_(options), ring_(options.capacity == 0 ? 1 : options.capacity) {
+    thread_ = std::thread(&EventBatcher::BatchThread, this);
+}
+
+EventBatcher::~EventBatcher() {
+    Stop();
+}
+
+void EventBatcher::OnTaskEvent(const TaskEvent& e) {
+    Entry entry{ e, Clock::now() };
+
+    // ֻµ״̬ʱ¼
+    while (!ring_.TryPush(entry)) {
+        Entry oldest;
+        if (ring_.TryPop(oldest)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // ÿֻ֡һ߳
+    if (!armed_.exchange(true)) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        cv_.notify_one();
+    }
+}
+
+void EventBatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void EventBatcher::BatchThread() {
+    Clock::time_point lastDelivery{};
+    EventBatch batch;
+    Entry entry;
+
+    for (;;) {
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_.wait(lk, [&]() { return stopping_ || armed_.load(); });
+
+            // һһ֡ʱȵһ֡ڼ䵽¼ͬһ
+            Clock::time_point next = lastDelivery + options_.frameInterval;
+            cv_.wait_until(lk, next, [&]() { return stopping_; });
+            stopping = stopping_;
+        }
+
+        // ־ȡ¼ȡ֮󵽴¼»
+        armed_.store(false);
+
+        batch.events.clear();
+        batch.firstQueued = Clock::time_point::max();
+        while (ring_.TryPop(entry)) {
+            if (entry.queued < batch.firstQueued) batch.firstQueued = entry.queued;
+            batch.events.push_back(std::move(entry.event));
+        }
+        batch.dropped = dropped_.exchange(0, std::memory_order_relaxed);
+
+        if (!batch.events.empty() || batch.dropped > 0) {
+            batch.delivered = Clock::now();
+            lastDelivery = batch.delivered;
+            sink_.OnEventBatch(batch);
+        }
+
+        if (stopping) break;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+#include "ITaskObserver.h"
+
+// һνһ¼
+struct EventBatch {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<TaskEvent> events;
+    Clock::time_point firstQueued;  // ¼ʱ
+    Clock::time_point delivered;    // շʱ
+    uint64_t dropped = 0;           // һ֮¼
+};
+
+class IEventBatchSink {
+public:
+    virtual ~IEventBatchSink() = default;
+    // ߳ϵãշֱ batch.events
+    virtual void OnEventBatch(EventBatch& batch) = 0;
+};
+
+struct EventBatcherOptions {
+    std::chrono::milliseconds frameInterval{ 16 };
+    size_t capacity = 4096;
+};
+
+// ƽ̨޹صĽ¼¼Ƚÿཻ֡һ
+// кĵһ¼Ƶʱÿֻ֡һ
+class EventBatcher : public ITaskObserver {
+public:
+    using Clock = EventBatch::Clock;
+
+    explicit EventBatcher(IEventBatchSink& sink, const EventBatcherOptions& options = {});
+    ~EventBatcher() override;
+
+    EventBatcher(const EventBatcher&) = delete;
+    EventBatcher& operator=(const EventBatcher&) = delete;
+
+    void OnTaskEvent(const TaskEvent& e) override;
+
+    // ʣ¼ֹͣ߳
+    void Stop();
+
+private:
+    struct Entry {
+        TaskEvent event;
+        Clock::time_point queued;
+    };
+
+    void BatchThread();
+
+    IEventBatchSink& sink_;
+    EventBatcherOptions options_;
+    BoundedQueue<Entry> ring_;
+    std::atomic<uint64_t> dropped_{ 0 };
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic<bool> armed_{ false };  // ¼ȴһ֡
+    bool stopping_ = false;             //  mtx_ 
+    std::thread thread_;
+};
\ No newline at end of file
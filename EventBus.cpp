@@ -0,0 +1,99 @@
+#include "EventBus.h"
+
+// ַ߳Լ¼ʱȴԼ
+static thread_local const EventBus* tlsDispatchingBus = nullptr;
+
+void EventBus::Start(const EventBusOptions& options, BatchHandler handler) {
+    if (running_) return;
+
+    options_ = options;
+    if (options_.capacity == 0) options_.capacity = 1;
+    handler_ = std::move(handler);
+    ring_ = std::make_unique<BoundedQueue<TaskEvent>>(options_.capacity);
+    dropped_ = 0;
+    running_ = true;
+    thread_ = std::thread(&EventBus::DispatchThread, this);
+}
+
+void EventBus::Stop() {
+    if (!running_.exchange(false)) return;
+    parker_.NotifyAll();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool EventBus::Publish(TaskEvent e) {
+    if (!running_ || !ring_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!ring_->TryPush(e)) {
+        EventOverflowPolicy policy = options_.policy;
+        if (policy == EventOverflowPolicy::Block && tlsDispatchingBus == this) {
+            policy = EventOverflowPolicy::DropNewest;
+        }
+
+        switch (policy) {
+        case EventOverflowPolicy::Block:
+            while (!ring_->TryPush(e)) {
+                if (!running_) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                parker_.NotifyOne();
+                std::this_thread::yield();
+            }
+            break;
+        case EventOverflowPolicy::DropNewest:
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case EventOverflowPolicy::DropOldest:
+            while (!ring_->TryPush(e)) {
+                TaskEvent oldest;
+                if (ring_->TryPop(oldest)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            break;
+        }
+    }
+
+    // ַ߳ûʱֻһԭӶ
+    parker_.NotifyOne();
+    return true;
+}
+
+size_t EventBus::Drain(std::vector<TaskEvent>& batch) {
+    batch.clear();
+    TaskEvent e;
+    while (batch.size() < kMaxBatch && ring_->TryPop(e)) {
+        batch.push_back(std::move(e));
+    }
+    return batch.size();
+}
+
+void EventBus::DispatchThread() {
+    tlsDispatchingBus = this;
+    std::vector<TaskEvent> batch;
+    batch.reserve(kMaxBatch);
+
+    for (;;) {
+        if (Drain(batch) > 0) {
+            handler_(batch);
+            continue;
+        }
+
+        // ֹͣȰѻſ˳
+        if (!running_) break;
+
+        uint64_t epoch = parker_.PrepareWait();
+        if (ring_->SizeApprox() > 0 || !running_) {
+            parker_.CancelWait();
+            continue;
+        }
+        parker_.Wait(epoch);
+    }
+    tlsDispatchingBus = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+#include "ITaskObserver.h"
+#include "Parker.h"
+
+// ¼ʱĴʽ
+enum class EventOverflowPolicy {
+    Block,       // ȴλ۲ʱ̣߳
+    DropNewest,  // ¼
+    DropOldest,  // ¼µ״̬
+};
+
+struct EventBusOptions {
+    size_t capacity = 8192;
+    EventOverflowPolicy policy = EventOverflowPolicy::DropOldest;
+};
+
+// 첽¼ߣ̰߳¼ŽԤ
+// רŵķַ̳߳ȡʽд־֪ͨ۲ߣ
+class EventBus {
+public:
+    using BatchHandler = std::function<void(std::vector<TaskEvent>& batch)>;
+
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+    ~EventBus() { Stop(); }
+
+    void Start(const EventBusOptions& options, BatchHandler handler);
+    // ַ껷ʣ¼󷵻
+    void Stop();
+
+    //  false ʾ¼
+    bool Publish(TaskEvent e);
+
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void DispatchThread();
+    size_t Drain(std::vector<TaskEvent>& batch);
+
+    static constexpr size_t kMaxBatch = 256;
+
+    EventBusOptions options_;
+    BatchHandler handler_;
+    std::unique_ptr<BoundedQueue<TaskEvent>> ring_;
+    Parker parker_;
+    std::atomic<bool> running_{ false };
+    std::atomic<uint64_t> dropped_{ 0 };
+    std::thread thread_;
+};
\ No newline at end of file
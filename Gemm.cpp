@@ -0,0 +1,369 @@
+#include "Gemm.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GEMM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC Ҫ /arch ʹ AVX ڽGCC/Clang ҪĿָ
+#if defined(_MSC_VER) && !defined(__clang__)
+#define GEMM_TARGET(isa)
+#define GEMM_INLINE __forceinline
+#else
+#define GEMM_TARGET(isa) __attribute__((target(isa)))
+#define GEMM_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace {
+
+using KernelFn = void (*)(size_t kc, const double* a, const double* b, double* c, size_t ldc, bool accumulate);
+
+// ΢ں˳ߴĬϷֿ
+struct KernelInfo {
+    GemmIsa isa;
+    size_t mr;
+    size_t nr;
+    GemmBlocking blocking;
+    KernelFn kernel;
+};
+
+constexpr size_t kMaxMr = 12;
+constexpr size_t kMaxNr = 16;
+
+// --------------------  4x4 --------------------
+void KernelScalar(size_t kc, const double* a, const double* b, double* c, size_t ldc, bool accumulate) {
+    double acc[4][4] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (int i = 0; i < 4; ++i) {
+            const double ai = a[i];
+            for (int j = 0; j < 4; ++j) acc[i][j] += ai * b[j];
+        }
+        a += 4;
+        b += 4;
+    }
+    for (int i = 0; i < 4; ++i) {
+        double* cr = c + i * ldc;
+        for (int j = 0; j < 4; ++j) cr[j] = accumulate ? cr[j] + acc[i][j] : acc[i][j];
+    }
+}
+
+#if defined(GEMM_X86)
+// -------------------- AVX2 + FMA 6x8 --------------------
+// 12 ۼӼĴ + 2  B + 1 㲥÷Ž 16  ymm
+GEMM_TARGET("avx2,fma") GEMM_INLINE void Fma256(const double* a, __m256d b0, __m256d b1, __m256d& lo, __m256d& hi) {
+    const __m256d ai = _mm256_broadcast_sd(a);
+    lo = _mm256_fmadd_pd(ai, b0, lo);
+    hi = _mm256_fmadd_pd(ai, b1, hi);
+}
+
+GEMM_TARGET("avx2,fma") GEMM_INLINE void Store256(double* cr, __m256d lo, __m256d hi, bool accumulate) {
+    if (accumulate) {
+        lo = _mm256_add_pd(lo, _mm256_loadu_pd(cr));
+        hi = _mm256_add_pd(hi, _mm256_loadu_pd(cr + 4));
+    }
+    _mm256_storeu_pd(cr, lo);
+    _mm256_storeu_pd(cr + 4, hi);
+}
+
+GEMM_TARGET("avx2,fma")
+void KernelAvx2(size_t kc, const double* a, const double* b, double* c, size_t ldc, bool accumulate) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        Fma256(a + 0, b0, b1, c00, c01);
+        Fma256(a + 1, b0, b1, c10, c11);
+        Fma256(a + 2, b0, b1, c20, c21);
+        Fma256(a + 3, b0, b1, c30, c31);
+        Fma256(a + 4, b0, b1, c40, c41);
+        Fma256(a + 5, b0, b1, c50, c51);
+        a += 6;
+        b += 8;
+    }
+
+    Store256(c + 0 * ldc, c00, c01, accumulate);
+    Store256(c + 1 * ldc, c10, c11, accumulate);
+    Store256(c + 2 * ldc, c20, c21, accumulate);
+    Store256(c + 3 * ldc, c30, c31, accumulate);
+    Store256(c + 4 * ldc, c40, c41, accumulate);
+    Store256(c + 5 * ldc, c50, c51, accumulate);
+}
+
+// -------------------- AVX-512 12x16 --------------------
+// 24 ۼӼĴ + 2  B + 1 㲥32  zmm 
+GEMM_TARGET("avx512f") GEMM_INLINE void Fma512(const double* a, __m512d b0, __m512d b1, __m512d& lo, __m512d& hi) {
+    const __m512d ai = _mm512_set1_pd(*a);
+    lo = _mm512_fmadd_pd(ai, b0, lo);
+    hi = _mm512_fmadd_pd(ai, b1, hi);
+}
+
+GEMM_TARGET("avx512f") GEMM_INLINE void Store512(double* cr, __m512d lo, __m512d hi, bool accumulate) {
+    if (accumulate) {
+        lo = _mm512_add_pd(lo, _mm512_loadu_pd(cr));
+        hi = _mm512_add_pd(hi, _mm512_loadu_pd(cr + 8));
+    }
+    _mm512_storeu_pd(cr, lo);
+    _mm512_storeu_pd(cr + 8, hi);
+}
+
+GEMM_TARGET("avx512f")
+void KernelAvx512(size_t kc, const double* a, const double* b, double* c, size_t ldc, bool accumulate) {
+    __m512d c00 = _mm512_setzero_pd(), c01 = _mm512_setzero_pd();
+    __m512d c10 = _mm512_setzero_pd(), c11 = _mm512_setzero_pd();
+    __m512d c20 = _mm512_setzero_pd(), c21 = _mm512_setzero_pd();
+    __m512d c30 = _mm512_setzero_pd(), c31 = _mm512_setzero_pd();
+    __m512d c40 = _mm512_setzero_pd(), c41 = _mm512_setzero_pd();
+    __m512d c50 = _mm512_setzero_pd(), c51 = _mm512_setzero_pd();
+    __m512d c60 = _mm512_setzero_pd(), c61 = _mm512_setzero_pd();
+    __m512d c70 = _mm512_setzero_pd(), c71 = _mm512_setzero_pd();
+    __m512d c80 = _mm512_setzero_pd(), c81 = _mm512_setzero_pd();
+    __m512d c90 = _mm512_setzero_pd(), c91 = _mm512_setzero_pd();
+    __m512d ca0 = _mm512_setzero_pd(), ca1 = _mm512_setzero_pd();
+    __m512d cb0 = _mm512_setzero_pd(), cb1 = _mm512_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p) {
+        const __m512d b0 = _mm512_loadu_pd(b);
+        const __m512d b1 = _mm512_loadu_pd(b + 8);
+        Fma512(a + 0, b0, b1, c00, c01);
+        Fma512(a + 1, b0, b1, c10, c11);
+        Fma512(a + 2, b0, b1, c20, c21);
+        Fma512(a + 3, b0, b1, c30, c31);
+        Fma512(a + 4, b0, b1, c40, c41);
+        Fma512(a + 5, b0, b1, c50, c51);
+        Fma512(a + 6, b0, b1, c60, c61);
+        Fma512(a + 7, b0, b1, c70, c71);
+        Fma512(a + 8, b0, b1, c80, c81);
+        Fma512(a + 9, b0, b1, c90, c91);
+        Fma512(a + 10, b0, b1, ca0, ca1);
+        Fma512(a + 11, b0, b1, cb0, cb1);
+        a += 12;
+        b += 16;
+    }
+
+    Store512(c + 0 * ldc, c00, c01, accumulate);
+    Store512(c + 1 * ldc, c10, c11, accumulate);
+    Store512(c + 2 * ldc, c20, c21, accumulate);
+    Store512(c + 3 * ldc, c30, c31, accumulate);
+    Store512(c + 4 * ldc, c40, c41, accumulate);
+    Store512(c + 5 * ldc, c50, c51, accumulate);
+    Store512(c + 6 * ldc, c60, c61, accumulate);
+    Store512(c + 7 * ldc, c70, c71, accumulate);
+    Store512(c + 8 * ldc, c80, c81, accumulate);
+    Store512(c + 9 * ldc, c90, c91, accumulate);
+    Store512(c + 10 * ldc, ca0, ca1, accumulate);
+    Store512(c + 11 * ldc, cb0, cb1, accumulate);
+}
+
+void CpuId(int leaf, int sub, unsigned out[4]) {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, leaf, sub);
+    for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned>(regs[i]);
+#else
+    __cpuid_count(leaf, sub, out[0], out[1], out[2], out[3]);
+#endif
+}
+
+// ϵͳлʱЩĴ״̬
+uint64_t EnabledXState() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+GemmIsa Detect() {
+#if defined(GEMM_X86)
+    unsigned r[4];
+    CpuId(0, 0, r);
+    const unsigned maxLeaf = r[0];
+    if (maxLeaf < 7) return GemmIsa::Scalar;
+
+    CpuId(1, 0, r);
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    const bool fma = (r[2] >> 12) & 1;
+    if (!osxsave || !avx) return GemmIsa::Scalar;
+
+    const uint64_t xcr0 = EnabledXState();
+    const bool ymm = (xcr0 & 0x6) == 0x6;      // XMM + YMM
+    const bool zmm = (xcr0 & 0xE6) == 0xE6;    //  opmask  ZMM λ
+    CpuId(7, 0, r);
+    const bool avx2 = (r[1] >> 5) & 1;
+    const bool avx512f = (r[1] >> 16) & 1;
+
+    if (avx512f && zmm) return GemmIsa::Avx512;
+    if (avx2 && fma && ymm) return GemmIsa::Avx2;
+#endif
+    return GemmIsa::Scalar;
+}
+
+const KernelInfo& SelectKernel(GemmIsa isa) {
+    static const KernelInfo kScalar{ GemmIsa::Scalar, 4, 4, { 64, 256, 1024 }, &KernelScalar };
+#if defined(GEMM_X86)
+    // kc x nr  B խԼռ L1 һ룬mc x kc  A  L2kc x nc  B  L3
+    static const KernelInfo kAvx2{ GemmIsa::Avx2, 6, 8, { 72, 256, 4080 }, &KernelAvx2 };
+    static const KernelInfo kAvx512{ GemmIsa::Avx512, 12, 16, { 144, 256, 4080 }, &KernelAvx512 };
+    const GemmIsa best = Gemm::DetectIsa();
+    if (isa > best) isa = best;
+    if (isa == GemmIsa::Avx512) return kAvx512;
+    if (isa == GemmIsa::Avx2) return kAvx2;
+#else
+    (void)isa;
+#endif
+    return kScalar;
+}
+
+size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// ÿ߳һݴ 64 ֽڶ룬ֻ
+class PackBuffer {
+public:
+    ~PackBuffer() { Free(); }
+
+    double* Reserve(size_t count) {
+        if (count > capacity_) {
+            Free();
+            data_ = static_cast<double*>(::operator new[](count * sizeof(double), std::align_val_t(64)));
+            capacity_ = count;
+        }
+        return data_;
+    }
+
+private:
+    void Free() {
+        if (data_) ::operator delete[](data_, std::align_val_t(64));
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    double* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+// A[mb x kb]  mr խխڰ mr в 0
+void PackA(const double* A, size_t lda, size_t mb, size_t kb, size_t mr, double* out) {
+    for (size_t i0 = 0; i0 < mb; i0 += mr) {
+        const size_t rows = std::min(mr, mb - i0);
+        const double* src = A + i0 * lda;
+        for (size_t p = 0; p < kb; ++p) {
+            size_t i = 0;
+            for (; i < rows; ++i) out[i] = src[i * lda + p];
+            for (; i < mr; ++i) out[i] = 0.0;
+            out += mr;
+        }
+    }
+}
+
+// B[kb x nb]  nr խխڰ nr в 0
+void PackB(const double* B, size_t ldb, size_t kb, size_t nb, size_t nr, double* out) {
+    for (size_t j0 = 0; j0 < nb; j0 += nr) {
+        const size_t cols = std::min(nr, nb - j0);
+        const double* src = B + j0;
+        for (size_t p = 0; p < kb; ++p) {
+            const double* row = src + p * ldb;
+            size_t j = 0;
+            for (; j < cols; ++j) out[j] = row[j];
+            for (; j < nr; ++j) out[j] = 0.0;
+            out += nr;
+        }
+    }
+}
+
+}
+
+GemmIsa Gemm::DetectIsa() {
+    static const GemmIsa isa = Detect();
+    return isa;
+}
+
+const char* Gemm::IsaName(GemmIsa isa) {
+    switch (isa) {
+    case GemmIsa::Avx512: return "AVX-512";
+    case GemmIsa::Avx2:   return "AVX2";
+    default:              return "Scalar";
+    }
+}
+
+bool Gemm::Multiply(const double* A, size_t lda, const double* B, size_t ldb, double* C, size_t ldc,
+    size_t M, size_t N, size_t K, const CancellationToken* token, GemmIsa isa, const GemmBlocking& blocking) {
+    if (M == 0 || N == 0) return true;
+    if (K == 0) {
+        for (size_t i = 0; i < M; ++i) std::fill(C + i * ldc, C + i * ldc + N, 0.0);
+        return true;
+    }
+
+    const KernelInfo& kern = SelectKernel(isa);
+    const size_t mr = kern.mr;
+    const size_t nr = kern.nr;
+    const size_t mc = RoundUp(blocking.mc ? blocking.mc : kern.blocking.mc, mr);
+    const size_t kc = blocking.kc ? blocking.kc : kern.blocking.kc;
+    const size_t nc = RoundUp(blocking.nc ? blocking.nc : kern.blocking.nc, nr);
+
+    thread_local PackBuffer bufA;
+    thread_local PackBuffer bufB;
+    double* packedA = bufA.Reserve(mc * kc);
+    double* packedB = bufB.Reserve(std::min(nc, RoundUp(N, nr)) * kc);
+
+    // Եһ΢ں˵ĿдٿЧ
+    alignas(64) double edge[kMaxMr * kMaxNr];
+
+    for (size_t jc = 0; jc < N; jc += nc) {
+        const size_t nb = std::min(nc, N - jc);
+        for (size_t pc = 0; pc < K; pc += kc) {
+            const size_t kb = std::min(kc, K - pc);
+            const bool accumulate = pc > 0;  // һֱӸ C÷Ҫ
+            PackB(B + pc * ldb + jc, ldb, kb, nb, nr, packedB);
+
+            for (size_t ic = 0; ic < M; ic += mc) {
+                if (token && token->IsCancelled()) return false;
+
+                const size_t mb = std::min(mc, M - ic);
+                PackA(A + ic * lda + pc, lda, mb, kb, mr, packedA);
+
+                // B խ㣬κ L2 ĸ A ʱһֱ L1
+                for (size_t jr = 0; jr < nb; jr += nr) {
+                    const size_t cols = std::min(nr, nb - jr);
+                    const double* bp = packedB + jr * kb;
+                    for (size_t ir = 0; ir < mb; ir += mr) {
+                        const size_t rows = std::min(mr, mb - ir);
+                        const double* ap = packedA + ir * kb;
+                        double* cp = C + (ic + ir) * ldc + jc + jr;
+
+                        if (rows == mr && cols == nr) {
+                            kern.kernel(kb, ap, bp, cp, ldc, accumulate);
+                            continue;
+                        }
+                        kern.kernel(kb, ap, bp, edge, nr, false);
+                        for (size_t i = 0; i < rows; ++i) {
+                            for (size_t j = 0; j < cols; ++j) {
+                                cp[i * ldc + j] = accumulate ? cp[i * ldc + j] + edge[i * nr + j] : edge[i * nr + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
\ No newline at end of file
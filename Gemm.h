@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include "CancellationToken.h"
+
+// ˫Ⱦ˷ںˣC = A * B
+//  Goto ʽֿ飺B  kc x nc  NR еխA  mc x kc  MR еխ
+// ΢ںڼĴۼ MR x NR  C 顣ڲѭʱ⵽ָѡ AVX-512 / AVX2+FMA / 
+enum class GemmIsa {
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+// ֿ0 ʾָȡĬֵmcnc ȡ΢ں˳ߴı
+struct GemmBlocking {
+    size_t mc = 0;  // A Ӧ L2
+    size_t kc = 0;  // άȷֶΣһ B խĳȣL1
+    size_t nc = 0;  // B Ӧ L3
+};
+
+namespace Gemm {
+
+// CPU Ͳϵͳֵָ֧״εʱ
+GemmIsa DetectIsa();
+const char* IsaName(GemmIsa isa);
+
+//  C[0..M) x [0..N) = A[M x K] * B[K x N]lda/ldb/ldc ΪпȣԪظ
+// ÿһ A һƣȡʱ falseʱ C ݲ
+// isa  DetectIsa() ʱ DetectIsa() ִ
+bool Multiply(const double* A, size_t lda, const double* B, size_t ldb, double* C, size_t ldc,
+    size_t M, size_t N, size_t K, const CancellationToken* token = nullptr,
+    GemmIsa isa = DetectIsa(), const GemmBlocking& blocking = {});
+
+}
\ No newline at end of file
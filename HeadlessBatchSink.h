@@ -0,0 +1,56 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "EventBatcher.h"
+
+// ޽νշLinux/ʹã¼ÿСӳ٣ں˶Ч
+// bench/EventBatchBench  EventBatcher ϲͶ
+class HeadlessBatchSink : public IEventBatchSink {
+public:
+    struct Stats {
+        size_t batches = 0;
+        size_t events = 0;
+        size_t maxBatch = 0;
+        uint64_t dropped = 0;
+        std::chrono::nanoseconds maxLatency{ 0 };    // ¼뻷
+        std::chrono::nanoseconds minInterval{ 0 };   // ̼
+    };
+
+    void OnEventBatch(EventBatch& batch) override {
+        std::lock_guard<std::mutex> lk(mtx_);
+        ++stats_.batches;
+        stats_.events += batch.events.size();
+        stats_.maxBatch = std::max(stats_.maxBatch, batch.events.size());
+        stats_.dropped += batch.dropped;
+        if (!batch.events.empty()) {
+            stats_.maxLatency = std::max(stats_.maxLatency,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(batch.delivered - batch.firstQueued));
+        }
+        if (stats_.batches > 1) {
+            auto gap = std::chrono::duration_cast<std::chrono::nanoseconds>(batch.delivered - lastDelivered_);
+            if (stats_.batches == 2 || gap < stats_.minInterval) stats_.minInterval = gap;
+        }
+        lastDelivered_ = batch.delivered;
+        batchSizes_.push_back(batch.events.size());
+    }
+
+    Stats GetStats() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return stats_;
+    }
+
+    std::vector<size_t> BatchSizes() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return batchSizes_;
+    }
+
+private:
+    mutable std::mutex mtx_;
+    Stats stats_;
+    EventBatch::Clock::time_point lastDelivered_{};
+    std::vector<size_t> batchSizes_;
+};
\ No newline at end of file
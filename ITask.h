@@ -1,10 +1,43 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include "CancellationToken.h"
+#include "TaskResult.h"
+#include "TaskNames.h"
 
 class ITask {
 public:
     virtual ~ITask() = default;
     virtual std::string GetName() const = 0;
     virtual std::string Execute(const CancellationTokenPtr& token) = 0;
+
+    // õڣַת
+    virtual TaskResult Run(const CancellationTokenPtr& token) {
+        return TaskResult::FromLegacy(Execute(token));
+    }
+
+    // ϲǿʱͬŶӻڼظύͬһִкͽ
+    virtual std::string GetCoalescingKey() const { return std::string(); }
+
+    // פƱţһεʱǼ GetName()֮ٷڴ
+    NameId GetNameId() const {
+        NameId id = nameId_.load(std::memory_order_relaxed);
+        if (id == kInvalidName) {
+            id = TaskNames::Intern(GetName());
+            nameId_.store(id, std::memory_order_relaxed);
+        }
+        return id;
+    }
+
+private:
+    mutable std::atomic<NameId> nameId_{ kInvalidName };
+};
+
+// ֱӷ TaskResult ֻʵ Run
+class TypedTask : public ITask {
+public:
+    std::string Execute(const CancellationTokenPtr& token) final {
+        return Run(token).payload;
+    }
+    TaskResult Run(const CancellationTokenPtr& token) override = 0;
 };
\ No newline at end of file
@@ -1,16 +1,24 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include "QueuePolicy.h"
+#include "TaskEvent.h"
 
-enum class TaskEventType { Started, Succeeded, Failed, Cancelled };
+enum class QueueFullAction { Blocked, Rejected, Dropped };
 
-struct TaskEvent {
-    TaskEventType type;
-    std::string taskName;
-    std::string message;
+// ύʱ֪ͨname Ǳܾ
+struct QueueFullEvent {
+    QueueFullAction action;
+    NameId name;
+    TaskPriority priority;
+    OverflowPolicy policy;
+    size_t capacity;
+    NameId group;
 };
 
 class ITaskObserver {
 public:
     virtual ~ITaskObserver() = default;
     virtual void OnTaskEvent(const TaskEvent& e) = 0;
+    virtual void OnQueueFull(const QueueFullEvent&) {}
 };
\ No newline at end of file
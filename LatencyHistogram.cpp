@@ -0,0 +1,183 @@
+#include "LatencyHistogram.h"
+#include <bit>
+#include <cmath>
+#include <memory>
+
+size_t LatencyHistogram::BucketIndex(uint64_t value) {
+    constexpr uint64_t kLinear = uint64_t(1) << kSubBits;
+    if (value < kLinear) return static_cast<size_t>(value);
+
+    //  kSubBits λ[2^(S-1), 2^S) ֮ top Ͱ
+    const int msb = 63 - std::countl_zero(value);
+    const int shift = msb - kSubBits + 1;
+    const uint64_t top = value >> shift;
+    return static_cast<size_t>((msb - kSubBits + 2) * (kLinear / 2) + (top - kLinear / 2));
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    constexpr size_t kLinear = size_t(1) << kSubBits;
+    if (index < kLinear) return index;
+
+    const size_t block = index / (kLinear / 2);
+    const uint64_t sub = index % (kLinear / 2) + kLinear / 2;
+    const int shift = static_cast<int>(block) - 1;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t valueNs) {
+    if (valueNs < 0) valueNs = 0;
+    if (valueNs > kMaxValue) valueNs = kMaxValue;
+
+    buckets_[BucketIndex(static_cast<uint64_t>(valueNs))].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(static_cast<uint64_t>(valueNs), std::memory_order_relaxed);
+
+    int64_t prev = max_.load(std::memory_order_relaxed);
+    while (valueNs > prev && !max_.compare_exchange_weak(prev, valueNs, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySummary LatencyHistogram::Summarize() const {
+    // ¼ʱͰͬһʱ̵ֵͳ;㹻
+    std::array<uint64_t, kBucketCount> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    LatencySummary s;
+    s.count = total;
+    s.maxNs = max_.load(std::memory_order_relaxed);
+    if (total == 0) return s;
+    s.meanNs = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(total);
+
+    const double quantiles[] = { 0.50, 0.99, 0.999 };
+    int64_t* outputs[] = { &s.p50Ns, &s.p99Ns, &s.p999Ns };
+    size_t q = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount && q < 3; ++i) {
+        seen += counts[i];
+        //  ceil(q * total) ڵͰ
+        while (q < 3 && seen > 0 && seen >= static_cast<uint64_t>(std::ceil(quantiles[q] * static_cast<double>(total)))) {
+            int64_t bound = static_cast<int64_t>(BucketUpperBound(i));
+            *outputs[q++] = bound < s.maxNs ? bound : s.maxNs;
+        }
+    }
+    return s;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        const uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+        if (n) buckets_[i].fetch_add(n, std::memory_order_relaxed);
+    }
+    count_.fetch_add(other.count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    const int64_t value = other.max_.load(std::memory_order_relaxed);
+    int64_t prev = max_.load(std::memory_order_relaxed);
+    while (value > prev && !max_.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+TaskLatencyTable::~TaskLatencyTable() {
+    for (auto& c : chunks_) {
+        Chunk* chunk = c.load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (auto& slot : chunk->slots) delete slot.load(std::memory_order_acquire);
+        delete chunk;
+    }
+}
+
+TaskLatency* TaskLatencyTable::Get(NameId name) {
+    if (name == kInvalidName) return nullptr;
+    const size_t c = name >> kChunkBits;
+    if (c >= kMaxChunks) return nullptr;
+
+    Chunk* chunk = chunks_[c].load(std::memory_order_acquire);
+    if (!chunk) {
+        // ߳ͬʱʱһͷԼ
+        auto* fresh = new Chunk();
+        if (chunks_[c].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+            chunk = fresh;
+        }
+        else {
+            delete fresh;
+        }
+    }
+
+    auto& slot = chunk->slots[name & (kChunkSize - 1)];
+    TaskLatency* stats = slot.load(std::memory_order_acquire);
+    if (!stats) {
+        auto* fresh = new TaskLatency();
+        if (slot.compare_exchange_strong(stats, fresh, std::memory_order_acq_rel)) {
+            stats = fresh;
+        }
+        else {
+            delete fresh;
+        }
+    }
+    return stats;
+}
+
+std::vector<TaskLatencyReport> TaskLatencyTable::Report() const {
+    std::vector<TaskLatencyReport> reports;
+    for (size_t c = 0; c < kMaxChunks; ++c) {
+        Chunk* chunk = chunks_[c].load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (size_t i = 0; i < kChunkSize; ++i) {
+            TaskLatency* stats = chunk->slots[i].load(std::memory_order_acquire);
+            if (!stats) continue;
+            TaskLatencyReport r;
+            r.name = TaskNames::Get(static_cast<NameId>((c << kChunkBits) | i));
+            r.queueWait = stats->queueWait.Summarize();
+            r.run = stats->run.Summarize();
+            r.notify = stats->notify.Summarize();
+            reports.push_back(std::move(r));
+        }
+    }
+    return reports;
+}
+
+TaskLatencyReport TaskLatencyTable::Total() const {
+    // ֱͼԼ 20KBڶ
+    auto total = std::make_unique<TaskLatency>();
+    for (size_t c = 0; c < kMaxChunks; ++c) {
+        Chunk* chunk = chunks_[c].load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (size_t i = 0; i < kChunkSize; ++i) {
+            TaskLatency* stats = chunk->slots[i].load(std::memory_order_acquire);
+            if (!stats) continue;
+            total->queueWait.Merge(stats->queueWait);
+            total->run.Merge(stats->run);
+            total->notify.Merge(stats->notify);
+        }
+    }
+    TaskLatencyReport r;
+    r.queueWait = total->queueWait.Summarize();
+    r.run = total->run.Summarize();
+    r.notify = total->notify.Summarize();
+    return r;
+}
+
+void TaskLatencyTable::Reset() {
+    for (auto& c : chunks_) {
+        Chunk* chunk = c.load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (auto& slot : chunk->slots) {
+            if (TaskLatency* stats = slot.load(std::memory_order_acquire)) {
+                stats->queueWait.Reset();
+                stats->run.Reset();
+                stats->notify.Reset();
+            }
+        }
+    }
+}
\ No newline at end of file
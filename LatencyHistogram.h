@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TaskNames.h"
+
+struct LatencySummary {
+    uint64_t count = 0;
+    double meanNs = 0;
+    int64_t p50Ns = 0;
+    int64_t p99Ns = 0;
+    int64_t p999Ns = 0;
+    int64_t maxNs = 0;
+};
+
+// HDR Ķ-ֱͼÿ 2 ٷ 64 ͰԼ 1.6%
+// ¼ֻм relaxed ԭӼӣ߳̿ͬʱ¼Ҳͬʱȡ
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 7;
+    static constexpr int64_t kMaxValue = (int64_t(1) << 44) - 1;  // Լ 4.9 СʱֵһͰ
+    static constexpr size_t kBucketCount = (44 - kSubBits + 2) * (size_t(1) << (kSubBits - 1));
+
+    void Record(int64_t valueNs);
+    LatencySummary Summarize() const;
+    void Reset();
+    // Ͱۼһֱͼϲķλͬһֱͼһ
+    void Merge(const LatencyHistogram& other);
+
+    // λȡͰϽ磨¼ֵ
+    static size_t BucketIndex(uint64_t value);
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{ 0 };
+    std::atomic<uint64_t> sum_{ 0 };
+    std::atomic<int64_t> max_{ 0 };
+};
+
+// һ񣨰Ʊ֣κʱ
+struct TaskLatency {
+    LatencyHistogram queueWait;  // ύʼִ
+    LatencyHistogram run;        // ʼЭʱ䣩
+    LatencyHistogram notify;     // ¼۲ߴ
+};
+
+struct TaskLatencyReport {
+    std::string name;
+    LatencySummary queueWait;
+    LatencySummary run;
+    LatencySummary notify;
+};
+
+//  NameId ֱͼ״õʱŷ䣬Ҳ
+class TaskLatencyTable {
+public:
+    TaskLatencyTable() = default;
+    TaskLatencyTable(const TaskLatencyTable&) = delete;
+    TaskLatencyTable& operator=(const TaskLatencyTable&) = delete;
+    ~TaskLatencyTable();
+
+    // ƱkInvalidNameʱ nullptr
+    TaskLatency* Get(NameId name);
+
+    std::vector<TaskLatencyReport> Report() const;
+    // ͰͰϲͳƣname Ϊ
+    TaskLatencyReport Total() const;
+    void Reset();
+
+private:
+    static constexpr size_t kChunkBits = 8;
+    static constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+    static constexpr size_t kMaxChunks = 4096;
+
+    struct Chunk {
+        std::atomic<TaskLatency*> slots[kChunkSize] = {};
+    };
+
+    std::atomic<Chunk*> chunks_[kMaxChunks] = {};
+};
\ No newline at end of file
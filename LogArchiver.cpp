@@ -0,0 +1,125 @@
+#include "LogArchiver.h"
+#include "ZipUtil.h"
+#include <Windows.h>
+#include <algorithm>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+LogArchiver::LogArchiver(const std::filesystem::path& logPath, size_t keepFiles, bool compress)
+    : dir_(logPath.parent_path()),
+      stem_(logPath.stem().string()),
+      extension_(logPath.extension().string()),
+      keepFiles_(keepFiles),
+      compress_(compress) {
+    thread_ = std::thread(&LogArchiver::ArchiveThread, this);
+}
+
+LogArchiver::~LogArchiver() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void LogArchiver::Enqueue(std::filesystem::path segment) {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        jobs_.push_back(std::move(segment));
+    }
+    cv_.notify_one();
+}
+
+void LogArchiver::ArchiveThread() {
+    //  CPU ʹ I/O ȼѹ͹߳Դ
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+    for (;;) {
+        std::filesystem::path segment;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_.wait(lk, [&]() { return stop_ || !jobs_.empty(); });
+            // ˳ǰѾתĶδ
+            if (jobs_.empty()) break;
+            segment = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        if (compress_) Compress(segment);
+        PruneOldSegments();
+    }
+
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+}
+
+void LogArchiver::Compress(const std::filesystem::path& segment) {
+    // ZipDirectoryShell ѹĿ¼ݣȰѶƽݴĿ¼
+    std::error_code ec;
+    std::filesystem::path staging = segment;
+    staging += ".tmp";
+    std::filesystem::create_directories(staging, ec);
+    std::filesystem::path staged = staging / segment.filename();
+    std::filesystem::rename(segment, staged, ec);
+    if (ec) {
+        std::cout << "Log archive: cannot stage " << segment.string() << ": " << ec.message() << std::endl;
+        return;
+    }
+
+    std::filesystem::path zipPath = segment;
+    zipPath += ".zip";
+    std::string err;
+    if (ZipDirectoryShell(staging, zipPath, &err)) {
+        // ZipDirectoryShell ȷ zip иöκŷأʱɾݴԭļ
+        std::filesystem::remove_all(staging, ec);
+        return;
+    }
+
+    // ѹʧʱδѹĶΣ᲻ȥڶݴĿ¼һ
+    std::cout << "Log archive: compress " << segment.string() << " failed: " << err << std::endl;
+    std::filesystem::rename(staged, segment, ec);
+    if (ec) {
+        std::cout << "Log archive: segment left in " << staging.string() << ": " << ec.message() << std::endl;
+        return;
+    }
+    std::filesystem::remove_all(staging, ec);
+    std::filesystem::remove(zipPath, ec);
+}
+
+void LogArchiver::PruneOldSegments() {
+    if (keepFiles_ == 0) return;
+
+    // תΪ stem.ʱ[-]ext[.zip]ȥչʱ˳
+    const std::string prefix = stem_ + ".";
+    const std::string zipExtension = extension_ + ".zip";
+    std::vector<std::pair<std::string, std::filesystem::path>> segments;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
+        if (!entry.is_regular_file(ec)) continue;
+        std::string name = entry.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) != 0) continue;
+
+        std::string key;
+        if (name.size() > zipExtension.size()
+            && name.compare(name.size() - zipExtension.size(), zipExtension.size(), zipExtension) == 0) {
+            key = name.substr(0, name.size() - zipExtension.size());
+        }
+        else if (name.size() > extension_.size()
+            && name.compare(name.size() - extension_.size(), extension_.size(), extension_) == 0) {
+            key = name.substr(0, name.size() - extension_.size());
+        }
+        else {
+            continue;
+        }
+        if (key.size() <= prefix.size()) continue;  // ǰдļ
+        segments.emplace_back(std::move(key), entry.path());
+    }
+    if (segments.size() <= keepFiles_) return;
+
+    std::sort(segments.begin(), segments.end());
+    const size_t excess = segments.size() - keepFiles_;
+    for (size_t i = 0; i < excess; ++i) {
+        std::filesystem::remove(segments[i].second, ec);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ת־ڵȼ̨߳ѹ zipļ
+// LogWriter תʱֻһȻ Enqueueд־·ѹ
+class LogArchiver {
+public:
+    // logPath ǵǰдļkeepFiles Ϊ 0 ʱɾ
+    LogArchiver(const std::filesystem::path& logPath, size_t keepFiles, bool compress);
+    ~LogArchiver();
+
+    void Enqueue(std::filesystem::path segment);
+
+private:
+    void ArchiveThread();
+    void Compress(const std::filesystem::path& segment);
+    void PruneOldSegments();
+
+    std::filesystem::path dir_;
+    std::string stem_;       // "scheduler"
+    std::string extension_;  // ".log"
+    size_t keepFiles_;
+    bool compress_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::filesystem::path> jobs_;
+    bool stop_ = false;
+    std::thread thread_;
+};
\ No newline at end of file
@@ -1,40 +1,356 @@
 #include "LogWriter.h"  // Ϊ·
-#include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include "LogArchiver.h"
+#include "TaskNames.h"
 
-static std::string NowStr() {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto t = system_clock::to_time_t(now);
-    std::tm tm{};
-    localtime_s(&tm, &t);
+static std::atomic<uint64_t> g_nextWriterSerial{ 1 };
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+static int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
 }
 
-LogWriter::LogWriter(const std::filesystem::path& logPath) {
+LogWriter::LogWriter(const std::filesystem::path& logPath, const LogWriterOptions& options)
+    : path_(logPath), options_(options), serial_(g_nextWriterSerial.fetch_add(1, std::memory_order_relaxed)) {
     std::filesystem::create_directories(logPath.parent_path());
-    ofs_.open(logPath, std::ios::out | std::ios::app);
-    if (ofs_) {
-        ofs_ << "===== Log Open: " << NowStr() << " =====\n";
-        ofs_.flush();
+    OpenFileLocked(NowNs());
+    open_ = ofs_.is_open();
+    if (open_) {
+        if (options_.rotateBytes > 0 || options_.rotatePeriod.count() > 0) {
+            archiver_ = std::make_unique<LogArchiver>(path_, options_.keepFiles, options_.compressRotated);
+        }
+        if (options_.async) {
+            flusher_ = std::thread(&LogWriter::FlushThread, this);
+        }
     }
 }
 
 LogWriter::~LogWriter() {
-    if (ofs_) {
-        ofs_ << "===== Log Close =====\n";
-        ofs_.flush();
+    if (flusher_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(wakeMtx_);
+            stop_ = true;
+        }
+        wakeCv_.notify_all();
+        flusher_.join();
+    }
+
+    // һд̨̣߳˳Ѹ̻߳ʣµȫд
+    std::lock_guard<std::mutex> lk(ioMtx_);
+    if (open_) {
+        try {
+            DrainLocked();
+        }
+        catch (...) {
+            // ʱ׳סĽ
+        }
+        WriteMarkerLocked("===== Log Close =====");
+        ofs_.close();
+    }
+}
+
+void LogWriter::Append(LogFmt format, std::string_view payload) {
+    if (!open_) return;
+    const int64_t now = NowNs();
+
+    if (!options_.async) {
+        std::lock_guard<std::mutex> lk(ioMtx_);
+        BeginChunkLocked(now);
+        WriteRecordLocked(now, format, payload);
+        CommitChunkLocked();
+        return;
+    }
+
+    ThreadBuffer& buf = LocalBuffer();
+    {
+        std::lock_guard<std::mutex> lk(buf.mtx);
+        buf.entries.push_back({ now, static_cast<uint32_t>(buf.text.size()), static_cast<uint32_t>(payload.size()), format });
+        buf.text.append(payload);
+    }
+
+    const size_t before = bufferedBytes_.fetch_add(payload.size(), std::memory_order_relaxed);
+    const size_t after = before + payload.size();
+    if (after >= options_.maxBufferedBytes) {
+        // ̸̨߳ϣɵǰ߳д̣ѹ
+        Flush();
+    }
+    else if (before < options_.flushBytes && after >= options_.flushBytes) {
+        {
+            std::lock_guard<std::mutex> lk(wakeMtx_);
+            wake_ = true;
+        }
+        wakeCv_.notify_one();
+    }
+}
+
+void LogWriter::Flush() {
+    if (!open_) return;
+    std::lock_guard<std::mutex> lk(ioMtx_);
+    DrainLocked();
+}
+
+LogWriter::ThreadBuffer& LogWriter::LocalBuffer() {
+    struct LocalSlot {
+        uint64_t serial = 0;
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+    thread_local LocalSlot slot;
+    if (slot.serial == serial_) return *slot.buffer;
+
+    // ߳˳󻺳ɵǼǱУʣµвᶪ
+    auto buffer = std::make_shared<ThreadBuffer>();
+    {
+        std::lock_guard<std::mutex> lk(regMtx_);
+        buffers_.push_back(buffer);
+    }
+    slot.serial = serial_;
+    slot.buffer = std::move(buffer);
+    return *slot.buffer;
+}
+
+void LogWriter::FlushThread() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(wakeMtx_);
+            wakeCv_.wait_for(lk, options_.flushInterval, [&]() { return wake_ || stop_; });
+            if (stop_) return;
+            wake_ = false;
+        }
+        std::lock_guard<std::mutex> lk(ioMtx_);
+        DrainLocked();
+    }
+}
+
+void LogWriter::DrainLocked() {
+    {
+        std::lock_guard<std::mutex> lk(regMtx_);
+        // ֻʣǼǱѾдյĻ˳߳
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+            [](const std::shared_ptr<ThreadBuffer>& b) { return b.use_count() == 1 && b->entries.empty(); }),
+            buffers_.end());
+        drainBuffers_.assign(buffers_.begin(), buffers_.end());
+    }
+    while (swapBuffers_.size() < drainBuffers_.size()) {
+        swapBuffers_.push_back(std::make_unique<ThreadBuffer>());
+    }
+
+    // Ϳյıûʱ޹
+    size_t bytes = 0;
+    size_t nonEmpty = 0;
+    for (size_t i = 0; i < drainBuffers_.size(); ++i) {
+        ThreadBuffer& spare = *swapBuffers_[i];
+        {
+            std::lock_guard<std::mutex> lk(drainBuffers_[i]->mtx);
+            spare.text.swap(drainBuffers_[i]->text);
+            spare.entries.swap(drainBuffers_[i]->entries);
+        }
+        bytes += spare.text.size();
+        if (spare.entries.empty()) continue;
+        ++nonEmpty;
+        for (const auto& e : spare.entries) {
+            lines_.push_back({ e.timestampNs, &spare, e });
+        }
+    }
+    drainBuffers_.clear();
+    if (lines_.empty()) return;
+    bufferedBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+
+    // ÿ߳ڲѾ򣬶߳ʱʱϲ
+    if (nonEmpty > 1) {
+        std::stable_sort(lines_.begin(), lines_.end(),
+            [](const PendingLine& a, const PendingLine& b) { return a.timestampNs < b.timestampNs; });
+    }
+
+    BeginChunkLocked(NowNs());
+    for (const auto& l : lines_) {
+        WriteRecordLocked(l.timestampNs, l.entry.format,
+            std::string_view(l.buffer->text).substr(l.entry.offset, l.entry.length));
+    }
+    lines_.clear();
+    for (auto& spare : swapBuffers_) {
+        spare->text.clear();
+        spare->entries.clear();
+    }
+
+    // һֻдһΡflush һ
+    CommitChunkLocked();
+}
+
+void LogWriter::OpenFileLocked(int64_t nowNs) {
+    auto mode = std::ios::out | std::ios::app;
+    if (options_.format == LogFileFormat::Binary) mode |= std::ios::binary;
+    ofs_.open(path_, mode);
+    if (!ofs_) {
         ofs_.close();
+        return;
+    }
+
+    std::error_code ec;
+    fileBytes_ = std::filesystem::file_size(path_, ec);
+    if (ec) fileBytes_ = 0;
+
+    if (options_.format == LogFileFormat::Binary) {
+        // ÿδ򿪶дļͷ׷ӵļʱ빤״̬
+        formatsWritten_.clear();
+        namesWritten_.clear();
+        lastTimestampNs_ = 0;
+        chunk_.assign(kLogMagic, sizeof(kLogMagic));
+        WriteRecordLocked(nowNs, LogFmt::Text, "===== Log Open =====");
+    }
+    else {
+        std::string stamp;
+        AppendTimestamp(nowNs, stamp);
+        chunk_ = "===== Log Open: " + stamp.substr(1, 19) + " =====\n";
+    }
+    ofs_.write(chunk_.data(), static_cast<std::streamsize>(chunk_.size()));
+    ofs_.flush();
+    fileBytes_ += chunk_.size();
+    chunk_.clear();
+
+    nextRotateNs_ = INT64_MAX;
+    if (options_.rotatePeriod.count() > 0) {
+        const int64_t periodNs = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.rotatePeriod).count();
+        const int64_t dayNs = 86400LL * 1000000000;
+        if (periodNs <= dayNs && dayNs % periodNs == 0) {
+            // 뵽ʱ㡢ȱ߽
+            std::time_t t = static_cast<std::time_t>(nowNs / 1000000000);
+            std::tm tm{};
+            localtime_s(&tm, &t);
+            const int64_t sinceMidnight = (tm.tm_hour * 3600LL + tm.tm_min * 60 + tm.tm_sec) * 1000000000
+                + nowNs % 1000000000;
+            nextRotateNs_ = nowNs - sinceMidnight % periodNs + periodNs;
+        }
+        else {
+            nextRotateNs_ = nowNs + periodNs;
+        }
+    }
+}
+
+void LogWriter::BeginChunkLocked(int64_t nowNs) {
+    if (!ofs_.is_open()) {
+        // ϴתû´򿪣һ
+        OpenFileLocked(nowNs);
+    }
+    else if (nowNs >= nextRotateNs_) {
+        RotateLocked(nowNs);
+    }
+    chunk_.clear();
+}
+
+void LogWriter::CommitChunkLocked() {
+    ofs_.write(chunk_.data(), static_cast<std::streamsize>(chunk_.size()));
+    ofs_.flush();
+    fileBytes_ += chunk_.size();
+    chunk_.clear();
+
+    if (options_.rotateBytes > 0 && fileBytes_ >= options_.rotateBytes && ofs_.is_open()) {
+        RotateLocked(NowNs());
     }
 }
 
-void LogWriter::WriteLine(const std::string& line) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    if (!ofs_) return;
-    ofs_ << "[" << NowStr() << "] " << line << "\n";
+void LogWriter::WriteMarkerLocked(const char* text) {
+    chunk_.clear();
+    if (options_.format == LogFileFormat::Binary) {
+        WriteRecordLocked(NowNs(), LogFmt::Text, text);
+    }
+    else {
+        chunk_ = text;
+        chunk_ += '\n';
+    }
+    ofs_.write(chunk_.data(), static_cast<std::streamsize>(chunk_.size()));
     ofs_.flush();
+    chunk_.clear();
+}
+
+void LogWriter::RotateLocked(int64_t nowNs) {
+    WriteMarkerLocked("===== Log Rotated =====");
+    ofs_.close();
+
+    // ʷΪ stem.-ʱ[-]extͬһڶתʱ
+    std::time_t t = static_cast<std::time_t>(nowNs / 1000000000);
+    std::tm tm{};
+    localtime_s(&tm, &t);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+
+    const std::string base = path_.stem().string() + "." + stamp;
+    const std::string ext = path_.extension().string();
+    std::filesystem::path target = path_.parent_path() / (base + ext);
+    std::error_code ec;
+    for (int n = 1; std::filesystem::exists(target, ec) || std::filesystem::exists(target.string() + ".zip", ec); ++n) {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "-%03d", n);
+        target = path_.parent_path() / (base + suffix + ext);
+    }
+
+    std::filesystem::rename(path_, target, ec);
+    OpenFileLocked(nowNs);
+
+    // ѹɶζֻ̨̣߳һ
+    if (!ec && archiver_) archiver_->Enqueue(target);
+}
+
+void LogWriter::WriteRecordLocked(int64_t timestampNs, LogFmt format, std::string_view payload) {
+    using namespace StructuredLog;
+
+    if (options_.format == LogFileFormat::Text) {
+        AppendTimestamp(timestampNs, chunk_);
+        if (format == LogFmt::Text) {
+            chunk_.append(payload);
+        }
+        else if (DecodeArgs(payload, args_)) {
+            Render(LogFormatTemplate(format), args_,
+                [](uint32_t id) { return std::string_view(TaskNames::Get(id)); }, chunk_);
+        }
+        chunk_ += '\n';
+        return;
+    }
+
+    // ƣģļһõʱд
+    auto index = static_cast<size_t>(format);
+    if (index >= formatsWritten_.size()) formatsWritten_.resize(index + 1);
+    if (!formatsWritten_[index]) {
+        formatsWritten_[index] = true;
+        WriteDefinitionLocked(LogRecordTag::FormatDef, static_cast<uint32_t>(index), LogFormatTemplate(format));
+    }
+    if (format != LogFmt::Text && DecodeArgs(payload, args_)) {
+        for (const auto& arg : args_) {
+            if (arg.type != LogArgType::Name) continue;
+            auto id = static_cast<size_t>(arg.u);
+            if (id >= namesWritten_.size()) namesWritten_.resize(id + 1);
+            if (namesWritten_[id]) continue;
+            namesWritten_[id] = true;
+            WriteDefinitionLocked(LogRecordTag::NameDef, static_cast<uint32_t>(id), TaskNames::Get(static_cast<NameId>(id)));
+        }
+    }
+
+    chunk_ += static_cast<char>(LogRecordTag::Entry);
+    PutVarint(chunk_, index);
+    PutVarint(chunk_, ZigZag(timestampNs - lastTimestampNs_));
+    lastTimestampNs_ = timestampNs;
+    PutVarint(chunk_, payload.size());
+    chunk_.append(payload);
+}
+
+void LogWriter::WriteDefinitionLocked(LogRecordTag tag, uint32_t id, std::string_view text) {
+    chunk_ += static_cast<char>(tag);
+    StructuredLog::PutVarint(chunk_, id);
+    StructuredLog::PutVarint(chunk_, text.size());
+    chunk_.append(text);
+}
+
+void LogWriter::AppendTimestamp(int64_t timestampNs, std::string& out) {
+    // ͬһڵиϴθʽĽlocaltime ÿһ
+    int64_t second = timestampNs / 1000000000;
+    if (timestampNs < 0 && second * 1000000000 != timestampNs) --second;
+    if (second != cachedSecond_) {
+        std::time_t t = static_cast<std::time_t>(second);
+        std::tm tm{};
+        localtime_s(&tm, &t);
+        std::strftime(cachedStamp_, sizeof(cachedStamp_), "[%Y-%m-%d %H:%M:%S] ", &tm);
+        cachedSecond_ = second;
+    }
+    out.append(cachedStamp_);
 }
\ No newline at end of file
@@ -1,17 +1,130 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <filesystem>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "StructuredLog.h"
 
+class LogArchiver;
+
+enum class LogFileFormat {
+    Text,    // ÿ "[ʱ] ı"
+    Binary,  // ṹƼ¼ LogDecoder תı JSON
+};
+
+struct LogWriterOptions {
+    // false ʱÿֱдļ flushԱʱã
+    bool async = true;
+    std::chrono::milliseconds flushInterval{ 200 };  // ̶̨߳ʱд
+    size_t flushBytes = 64 * 1024;                   // ѹֵѺ̨߳
+    size_t maxBufferedBytes = 4 * 1024 * 1024;       // ѹޣʱд־߳Լд
+    LogFileFormat format = LogFileFormat::Text;
+
+    // תһʱѵǰļΪ stem.ʱext ´򿪣Ϊ 0 ʱת
+    uint64_t rotateBytes = 0;
+    std::chrono::minutes rotatePeriod{ 0 };  // һʱʱ루㡢㣩
+    size_t keepFiles = 10;                   // ʷ0 ʾɾ
+    bool compressRotated = true;             // ʷں̨ѹ zip
+};
+
+// 첽ģʽ WriteLine ֻʱı׷ӵ̵߳Ļ
+// ʽʱ䡢дļflush ں̨߳ϰ
 class LogWriter {
 public:
-    explicit LogWriter(const std::filesystem::path& logPath);
+    explicit LogWriter(const std::filesystem::path& logPath, const LogWriterOptions& options = {});
     ~LogWriter();
 
-    void WriteLine(const std::string& line);
+    void WriteLine(std::string_view line) { Append(LogFmt::Text, line); }
+
+    // ṹ־ֻʽƳٵдʱļ򲻸ʽ
+    // Log(LogFmt::TaskSucceeded, LogName{ nameId }, result.payload)
+    template <class... Args>
+    void Log(LogFmt format, const Args&... args) {
+        if (!open_) return;
+        thread_local std::string payload;
+        payload.clear();
+        (StructuredLog::EncodeArg(payload, args), ...);
+        Append(format, payload);
+    }
+
+    // ߳дд̺󷵻
+    void Flush();
 
 private:
+    struct Entry {
+        int64_t timestampNs;  // system_clock
+        uint32_t offset;
+        uint32_t length;
+        LogFmt format;
+    };
+
+    // ÿд־߳һֻб̺߳д̷
+    struct ThreadBuffer {
+        std::mutex mtx;
+        std::string text;
+        std::vector<Entry> entries;
+    };
+
+    struct PendingLine {
+        int64_t timestampNs;
+        const ThreadBuffer* buffer;
+        Entry entry;
+    };
+
+    void Append(LogFmt format, std::string_view payload);
+    ThreadBuffer& LocalBuffer();
+    void FlushThread();
+    // ÷ ioMtx_
+    void DrainLocked();
+    void WriteRecordLocked(int64_t timestampNs, LogFmt format, std::string_view payload);
+    void WriteDefinitionLocked(LogRecordTag tag, uint32_t id, std::string_view text);
+    // ļдļͷļĶʱ׼¿ʼ
+    void OpenFileLocked(int64_t nowNs);
+    // ʱתҪڱ֮ǰжϣСתдһ֮ж
+    void BeginChunkLocked(int64_t nowNs);
+    void CommitChunkLocked();
+    void RotateLocked(int64_t nowNs);
+    void WriteMarkerLocked(const char* text);
+    void AppendTimestamp(int64_t timestampNs, std::string& out);
+
+    std::filesystem::path path_;
     std::ofstream ofs_;
-    std::mutex mtx_;
+    bool open_ = false;  // 󲻱䣬д־̲߳״̬
+    LogWriterOptions options_;
+    uint64_t fileBytes_ = 0;
+    int64_t nextRotateNs_ = INT64_MAX;
+    std::unique_ptr<LogArchiver> archiver_;
+    const uint64_t serial_;  // ʵֲ߳̾ǵַ
+
+    std::mutex regMtx_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+    // д̷⣻³Աֻڳ ioMtx_ ʱʹ
+    std::mutex ioMtx_;
+    std::vector<std::shared_ptr<ThreadBuffer>> drainBuffers_;
+    std::vector<std::unique_ptr<ThreadBuffer>> swapBuffers_;
+    std::vector<PendingLine> lines_;
+    std::string chunk_;
+    int64_t cachedSecond_ = INT64_MIN;
+    char cachedStamp_[24] = {};
+    std::vector<LogArg> args_;
+    // ļλỰдĶһ¼ʱ
+    std::vector<bool> formatsWritten_;
+    std::vector<bool> namesWritten_;
+    int64_t lastTimestampNs_ = 0;
+
+    std::atomic<size_t> bufferedBytes_{ 0 };
+    std::mutex wakeMtx_;
+    std::condition_variable wakeCv_;
+    bool wake_ = false;
+    bool stop_ = false;
+    std::thread flusher_;
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "CancellationToken.h"
+#include "Gemm.h"
+
+// ˷ģ壺C = A * BN x NԪ float / double / int32_t
+// N Ϊ 8/16/32/64 ʱ߱չĹ̶ߴںˣݷջϣڴ棩
+// ߴ߷ֿͨ·double ͨ· Gemm Ĵ SIMD ں
+enum class MatrixElement {
+    Float,
+    Double,
+    Int32
+};
+
+template <class T>
+inline constexpr bool kIsMatrixElement =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+template <class T>
+constexpr const char* MatrixElementName() {
+    static_assert(kIsMatrixElement<T>, "matrix element must be float, double or int32_t");
+    if constexpr (std::is_same_v<T, float>) return "float";
+    else if constexpr (std::is_same_v<T, double>) return "double";
+    else return "int32";
+}
+
+constexpr bool IsUnrolledMatrixSize(size_t n) {
+    return n == 8 || n == 16 || n == 32 || n == 64;
+}
+
+// ڳߴľ󣬰ֵ
+template <class T, size_t N>
+using FixedMatrix = std::array<T, N * N>;
+
+namespace MatrixKernel {
+
+// һ CѭǱڳȫչ j ۼǾֲ飬 A/B/C 
+template <class T, size_t N>
+constexpr void FixedRow(const T* a, const T* B, T* c) {
+    T acc[N] = {};
+    for (size_t k = 0; k < N; ++k) {
+        const T ak = a[k];
+        const T* b = B + k * N;
+        for (size_t j = 0; j < N; ++j) acc[j] += ak * b[j];
+    }
+    for (size_t j = 0; j < N; ++j) c[j] = acc[j];
+}
+
+template <class T, size_t N>
+constexpr void Fixed(const T* A, const T* B, T* C) {
+    static_assert(kIsMatrixElement<T>, "matrix element must be float, double or int32_t");
+    static_assert(IsUnrolledMatrixSize(N), "fixed kernels exist for N = 8, 16, 32, 64");
+    for (size_t i = 0; i < N; ++i) {
+        FixedRow<T, N>(A + i * N, B, C + i * N);
+    }
+}
+
+// ͨ÷ֿ·C[M x N] = A[M x K] * B[K x N]ÿһһƣȡ false
+// i-k-j ˳ڲ BC ʣ
+template <class T>
+bool Blocked(const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc,
+    size_t M, size_t N, size_t K, const CancellationToken* token = nullptr) {
+    static_assert(kIsMatrixElement<T>, "matrix element must be float, double or int32_t");
+    if constexpr (std::is_same_v<T, double>) {
+        return Gemm::Multiply(A, lda, B, ldb, C, ldc, M, N, K, token);
+    }
+    else {
+        constexpr size_t kBlockM = 64;
+        constexpr size_t kBlockN = 256;
+        constexpr size_t kBlockK = 128;
+
+        for (size_t i = 0; i < M; ++i) {
+            for (size_t j = 0; j < N; ++j) C[i * ldc + j] = T(0);
+        }
+        for (size_t kk = 0; kk < K; kk += kBlockK) {
+            const size_t kEnd = kk + kBlockK < K ? kk + kBlockK : K;
+            for (size_t jj = 0; jj < N; jj += kBlockN) {
+                const size_t jEnd = jj + kBlockN < N ? jj + kBlockN : N;
+                for (size_t ii = 0; ii < M; ii += kBlockM) {
+                    if (token && token->IsCancelled()) return false;
+                    const size_t iEnd = ii + kBlockM < M ? ii + kBlockM : M;
+                    size_t i = ii;
+                    // һ飺ÿζ B Ԫع C ʹ
+                    for (; i + 4 <= iEnd; i += 4) {
+                        T* c0 = C + i * ldc;
+                        T* c1 = c0 + ldc;
+                        T* c2 = c1 + ldc;
+                        T* c3 = c2 + ldc;
+                        for (size_t k = kk; k < kEnd; ++k) {
+                            const T a0 = A[i * lda + k];
+                            const T a1 = A[(i + 1) * lda + k];
+                            const T a2 = A[(i + 2) * lda + k];
+                            const T a3 = A[(i + 3) * lda + k];
+                            const T* b = B + k * ldb;
+                            for (size_t j = jj; j < jEnd; ++j) {
+                                const T bj = b[j];
+                                c0[j] += a0 * bj;
+                                c1[j] += a1 * bj;
+                                c2[j] += a2 * bj;
+                                c3[j] += a3 * bj;
+                            }
+                        }
+                    }
+                    for (; i < iEnd; ++i) {
+                        T* c = C + i * ldc;
+                        for (size_t k = kk; k < kEnd; ++k) {
+                            const T a = A[i * lda + k];
+                            const T* b = B + k * ldb;
+                            for (size_t j = jj; j < jEnd; ++j) c[j] += a * b[j];
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+}
+
+// ڳߴ磺8/16/32/64 չںˣڳʽֵ
+template <class T, size_t N>
+constexpr void MatrixMultiply(const FixedMatrix<T, N>& A, const FixedMatrix<T, N>& B, FixedMatrix<T, N>& C) {
+    if constexpr (IsUnrolledMatrixSize(N)) {
+        MatrixKernel::Fixed<T, N>(A.data(), B.data(), C.data());
+    }
+    else {
+        MatrixKernel::Blocked<T>(A.data(), N, B.data(), N, C.data(), N, N, N, N);
+    }
+}
+
+// ڳߴ磺n ǡչߴʱͬ߹̶ںˣȡ false
+template <class T>
+bool MatrixMultiply(const T* A, const T* B, T* C, size_t n, const CancellationToken* token = nullptr) {
+    switch (n) {
+    case 8:  MatrixKernel::Fixed<T, 8>(A, B, C); return true;
+    case 16: MatrixKernel::Fixed<T, 16>(A, B, C); return true;
+    case 32: MatrixKernel::Fixed<T, 32>(A, B, C); return true;
+    case 64: MatrixKernel::Fixed<T, 64>(A, B, C); return true;
+    default: return MatrixKernel::Blocked<T>(A, n, B, n, C, n, n, n, n, token);
+    }
+}
\ No newline at end of file
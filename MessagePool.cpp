@@ -0,0 +1,82 @@
+#include "MessagePool.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+struct alignas(64) Slot {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    uint64_t tag = 0;
+    uint32_t length = 0;
+    char data[MessagePool::kSlotBytes];
+};
+
+struct Pool {
+    std::atomic<uint64_t> next{ 1 };
+    std::atomic<uint64_t> lost{ 0 };
+    Slot slots[MessagePool::kSlots];
+};
+
+Pool& Instance() {
+    // ⲻͬƱ
+    static Pool* pool = new Pool();
+    return *pool;
+}
+
+// ٽֻһ memcpy
+class SlotLock {
+public:
+    explicit SlotLock(Slot& slot) : slot_(slot) {
+        while (slot_.lock.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    ~SlotLock() { slot_.lock.clear(std::memory_order_release); }
+
+private:
+    Slot& slot_;
+};
+
+}  // namespace
+
+MessageRef MessagePool::Store(std::string_view text) {
+    if (text.empty()) return MessageRef{};
+
+    Pool& pool = Instance();
+    uint64_t tag = pool.next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = pool.slots[tag % kSlots];
+
+    size_t len = text.size();
+    size_t mark = 0;
+    if (len > kSlotBytes) {
+        // ضϱǵλã˵ UTF-8 ַ߽磬ַ
+        len = kSlotBytes - kTruncatedText.size();
+        while (len > 0 && (static_cast<unsigned char>(text[len]) & 0xC0) == 0x80) --len;
+        mark = kTruncatedText.size();
+    }
+    SlotLock lk(slot);
+    std::memcpy(slot.data, text.data(), len);
+    std::memcpy(slot.data + len, kTruncatedText.data(), mark);
+    slot.length = static_cast<uint32_t>(len + mark);
+    slot.tag = tag;
+    return MessageRef{ tag };
+}
+
+bool MessagePool::AppendTo(MessageRef ref, std::string& out) {
+    if (ref.Empty()) return false;
+
+    Pool& pool = Instance();
+    Slot& slot = pool.slots[ref.tag % kSlots];
+    SlotLock lk(slot);
+    if (slot.tag != ref.tag) {
+        pool.lost.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    out.append(slot.data, slot.length);
+    return true;
+}
+
+uint64_t MessagePool::Lost() {
+    return Instance().lost.load(std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Ϣãtag Ϊ 0 ʾûϢ
+struct MessageRef {
+    uint64_t tag = 0;
+
+    bool Empty() const { return tag == 0; }
+};
+
+// ¼Ϣأ̶̶СĲλѭʹãȡڴ
+// λϢǺöݣ kSlotBytes Ϣضϣβ kTruncatedText
+// λĬ¼ӽŶе¼ᱻǣ EventBatcher.cpp
+// ̵߳ѾϢıòλ
+class MessagePool {
+public:
+    static constexpr size_t kSlots = 16384;
+    static constexpr size_t kSlotBytes = 256;
+
+    // Ϣѱʱԭʾ
+    static constexpr std::string_view kLostText = "<message lost>";
+    // ضϵϢԴ˽β
+    static constexpr std::string_view kTruncatedText = "...<truncated>";
+
+    static MessageRef Store(std::string_view text);
+
+    // Ϣ׷ӵ outûϢѱʱ false
+    static bool AppendTo(MessageRef ref, std::string& out);
+
+    // λѱǶȡʧܵĴ
+    static uint64_t Lost();
+};
\ No newline at end of file
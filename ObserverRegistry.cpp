@@ -0,0 +1,93 @@
+#include "ObserverRegistry.h"
+#include <algorithm>
+
+// ͨƥ䣺* ƥ⴮? ƥ䵥ַ
+static bool GlobMatch(const std::string& pattern, const std::string& text) {
+    size_t p = 0, t = 0;
+    size_t star = std::string::npos, mark = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        }
+        else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = t;
+        }
+        else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++mark;
+        }
+        else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+bool ObserverFilter::MatchName(NameId name) const {
+    if (namePattern.empty()) return true;
+    if (!wildcard_) return name == exactName_;
+    return GlobMatch(namePattern, TaskNames::Get(name));
+}
+
+bool ObserverFilter::Accepts(TaskEventType type, NameId name, NameId group) const {
+    if ((types & Bit(type)) == 0) return false;
+    if (!this->group.empty() && group != groupId_) return false;
+    return MatchName(name);
+}
+
+bool ObserverFilter::AcceptsQueueFull(NameId name, NameId group) const {
+    if ((types & kQueueFull) == 0) return false;
+    if (!this->group.empty() && group != groupId_) return false;
+    return MatchName(name);
+}
+
+ObserverRegistry::ObserverRegistry() : snapshot_(std::make_shared<const Snapshot>()) {
+}
+
+ObserverRegistry::SubscriptionId ObserverRegistry::Add(std::weak_ptr<ITaskObserver> observer, ObserverFilter filter) {
+    filter.wildcard_ = filter.namePattern.find_first_of("*?") != std::string::npos;
+    if (!filter.namePattern.empty() && !filter.wildcard_) {
+        filter.exactName_ = TaskNames::Intern(filter.namePattern);
+    }
+    if (!filter.group.empty()) {
+        filter.groupId_ = TaskNames::Intern(filter.group);
+    }
+
+    std::lock_guard<std::mutex> lk(writeMtx_);
+    auto next = std::make_shared<Snapshot>(*Load());
+    SubscriptionId id = nextId_++;
+    next->push_back({ id, std::move(observer), std::move(filter) });
+    snapshot_.store(std::move(next), std::memory_order_release);
+    return id;
+}
+
+bool ObserverRegistry::Remove(SubscriptionId id) {
+    std::lock_guard<std::mutex> lk(writeMtx_);
+    auto current = Load();
+    auto it = std::find_if(current->begin(), current->end(),
+        [id](const Subscription& s) { return s.id == id; });
+    if (it == current->end()) return false;
+
+    auto next = std::make_shared<Snapshot>();
+    next->reserve(current->size() - 1);
+    for (const auto& s : *current) {
+        if (s.id != id) next->push_back(s);
+    }
+    snapshot_.store(std::move(next), std::memory_order_release);
+    return true;
+}
+
+void ObserverRegistry::RemoveExpired() {
+    std::lock_guard<std::mutex> lk(writeMtx_);
+    auto current = Load();
+    auto next = std::make_shared<Snapshot>();
+    for (const auto& s : *current) {
+        if (!s.observer.expired()) next->push_back(s);
+    }
+    if (next->size() != current->size()) {
+        snapshot_.store(std::move(next), std::memory_order_release);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ITaskObserver.h"
+#include "TaskNames.h"
+
+// Ĺڵù۲֮ǰж
+struct ObserverFilter {
+    static constexpr uint32_t Bit(TaskEventType type) { return 1u << static_cast<uint32_t>(type); }
+    static constexpr uint32_t kQueueFull = 1u << 4;
+    static constexpr uint32_t kAll = 0x1Fu;
+
+    uint32_t types = kAll;    // TaskEventType λ룬 kQueueFull
+    std::string namePattern;  // ͨ*  ?ձʾȫ
+    std::string group;        // 飬ձʾȫ
+
+    bool Accepts(TaskEventType type, NameId name, NameId group) const;
+    bool AcceptsQueueFull(NameId name, NameId group) const;
+
+private:
+    friend class ObserverRegistry;
+    bool MatchName(NameId name) const;
+
+    // ǼʱԤȼ㣺ͨƺͷֱӱȽϱ
+    NameId exactName_ = kInvalidName;
+    NameId groupId_ = kInvalidName;
+    bool wildcard_ = false;
+};
+
+// ۲ߵǼǱֻزɱգɾʱƺ滻RCU ʽ
+// ͷַдߵĻ
+class ObserverRegistry {
+public:
+    using SubscriptionId = uint64_t;
+
+    struct Subscription {
+        SubscriptionId id;
+        std::weak_ptr<ITaskObserver> observer;
+        ObserverFilter filter;
+    };
+    using Snapshot = std::vector<Subscription>;
+
+    ObserverRegistry();
+
+    SubscriptionId Add(std::weak_ptr<ITaskObserver> observer, ObserverFilter filter);
+    bool Remove(SubscriptionId id);
+    // ѾĹ۲
+    void RemoveExpired();
+
+    std::shared_ptr<const Snapshot> Load() const {
+        return snapshot_.load(std::memory_order_acquire);
+    }
+
+    size_t Size() const { return Load()->size(); }
+
+private:
+    std::mutex writeMtx_;  // ֻлд
+    SubscriptionId nextId_ = 1;
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// ߳/ѣevent count
+// ÷epoch = PrepareWait(); ټһζУΪ Wait(epoch) CancelWait()
+// û߳ʱ NotifyOne() ֻһԭӱ
+class Parker {
+public:
+    uint64_t PrepareWait() {
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    void CancelWait() {
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Wait(uint64_t epoch) {
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_.wait(lk, [&]() { return epoch_.load(std::memory_order_acquire) != epoch; });
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void NotifyOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            epoch_.fetch_add(1, std::memory_order_release);
+        }
+        cv_.notify_one();
+    }
+
+    // ύ໽ n ߳
+    void NotifyMany(size_t n) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t sleepers = sleepers_.load(std::memory_order_relaxed);
+        if (sleepers == 0 || n == 0) return;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            epoch_.fetch_add(1, std::memory_order_release);
+        }
+        if (n >= sleepers) {
+            cv_.notify_all();
+        }
+        else {
+            for (size_t i = 0; i < n; ++i) cv_.notify_one();
+        }
+    }
+
+    void NotifyAll() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            epoch_.fetch_add(1, std::memory_order_release);
+        }
+        cv_.notify_all();
+    }
+
+    size_t Sleepers() const { return sleepers_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<size_t> sleepers_{ 0 };
+    std::atomic<uint64_t> epoch_{ 0 };
+    std::mutex mtx_;
+    std::condition_variable cv_;
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+// ύȼ̰߳ High -> Normal -> Low ˳ȡ
+enum class TaskPriority { High, Normal, Low };
+constexpr size_t kTaskPriorityCount = 3;
+
+// ύʱĴʽ
+enum class OverflowPolicy {
+    Block,           // ύֱпλ
+    Reject,          // ܾ񣬾Ϊ Rejected
+    DropOldest,      // ͬȼͬȼΪʱȡȼ
+    ShedByPriority,  // ȼûܾ
+};
+
+// ⲿ߳ύһ߳ڲύ
+struct QueueOptions {
+    size_t capacity = 4096;
+    OverflowPolicy policy = OverflowPolicy::Block;
+};
\ No newline at end of file
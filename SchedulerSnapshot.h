@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "QueuePolicy.h"
+
+// TaskScheduler::Snapshot() Ľֱȡ˴֮䲻ͬһʱ̵ϸһͼ
+struct WorkerSnapshot {
+    size_t index = 0;
+    bool busy = false;
+    uint64_t taskId = 0;                         // busy ʱЧ
+    std::string taskName;
+    std::chrono::steady_clock::duration busyFor{};  // ǰִеʱ
+    size_t localQueue = 0;                        // ߳Լе񣨺ָЭ̣
+    uint64_t tasksRun = 0;
+    std::chrono::steady_clock::duration busyTotal{};  //  Start ۼִʱ䣨ǰ
+    double utilization = 0;                       //  Start æµʱռ
+};
+
+struct InFlightTask {
+    uint64_t id = 0;
+    std::string name;
+    std::chrono::steady_clock::duration elapsed{};  // Կʼִ
+    bool suspended = false;                          // ЭУռù߳
+    int worker = -1;                                 // ִḶ́߳ʱΪ -1
+};
+
+struct SchedulerSnapshot {
+    bool running = false;
+    std::chrono::steady_clock::duration uptime{};
+
+    size_t laneDepth[kTaskPriorityCount] = {};  //  TaskPriority ±
+    size_t queued = 0;                          // ύе
+
+    std::vector<WorkerSnapshot> workers;
+    std::vector<InFlightTask> inFlight;
+
+    uint64_t submitted = 0;
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    uint64_t cancelled = 0;
+    uint64_t rejected = 0;
+
+    size_t observerCount = 0;
+    uint64_t eventsDropped = 0;
+    uint64_t messagesLost = 0;  // ¼ϢڶȡǰѱǵĴMessagePool::Lostۼƣ
+};
\ No newline at end of file
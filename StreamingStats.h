@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <cmath>
+
+// ʽͳƣֵСֵֵռڴ޹
+// ۼ Welford ƣݲֽ Chan ĺϲʽϳɣ
+// ̷ֱ߳ͳһٺϲһͳȫֻͬ룩
+class RunningStats {
+public:
+    void Add(double x) {
+        ++count_;
+        const double delta = x - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (x - mean_);
+        if (x < min_) min_ = x;
+        if (x > max_) max_ = x;
+    }
+
+    // һڻеھֵƽͣκϲ
+    // ʡȥÿһγڲѭ
+    template <class It>
+    void AddRange(It first, It last) {
+        if (first == last) return;
+
+        RunningStats part;
+        double sum = 0.0;
+        double lo = static_cast<double>(*first);
+        double hi = lo;
+        for (It it = first; it != last; ++it) {
+            const double x = static_cast<double>(*it);
+            sum += x;
+            lo = x < lo ? x : lo;
+            hi = x > hi ? x : hi;
+            ++part.count_;
+        }
+        part.mean_ = sum / static_cast<double>(part.count_);
+        for (It it = first; it != last; ++it) {
+            const double d = static_cast<double>(*it) - part.mean_;
+            part.m2_ += d * d;
+        }
+        part.min_ = lo;
+        part.max_ = hi;
+        Merge(part);
+    }
+
+    void Merge(const RunningStats& other) {
+        if (other.count_ == 0) return;
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+
+        const double n1 = static_cast<double>(count_);
+        const double n2 = static_cast<double>(other.count_);
+        const double n = n1 + n2;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * (n2 / n);
+        m2_ += other.m2_ + delta * delta * (n1 / n * n2);
+        count_ += other.count_;
+        if (other.min_ < min_) min_ = other.min_;
+        if (other.max_ > max_) max_ = other.max_;
+    }
+
+    uint64_t Count() const { return count_; }
+    double Mean() const { return mean_; }
+    // 巽 nûʱΪ 0
+    double Variance() const { return count_ > 0 ? m2_ / static_cast<double>(count_) : 0.0; }
+    //  n - 1
+    double SampleVariance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+    double StdDev() const { return std::sqrt(Variance()); }
+    // ûʱ Min Ϊ +infMax Ϊ -inf
+    double Min() const { return min_; }
+    double Max() const { return max_; }
+
+private:
+    uint64_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;  // ƽ
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "StructuredLog.h"
+#include <algorithm>
+#include <cstdio>
+
+static const char* const kTemplates[] = {
+    "{}",
+    "TaskScheduler started with {} workers",
+    "ExecuteImmediately: {}",
+    "ExecuteImmediately: {} coalesced into task #{}",
+    "ScheduleAfter: {} in {}ms",
+    "ScheduleEvery: {} every {}ms",
+    "Timer cancelled: {}",
+    "CancelGroup: {} ({} tasks)",
+    "WorkerThread #{} started",
+    "WorkerThread #{} got task: {}",
+    "WorkerThread #{} stole task: {}",
+    "WorkerThread #{} ended",
+    "Task cancelled before start: {}",
+    "Executing task: {}",
+    "Task cancelled during execution: {}",
+    "Task failed: {} Error: {}",
+    "Task succeeded: {} Result: {}",
+    "Task cancelled (exception): {} Error: {}",
+    "Task unknown error: {}",
+    "Task completed: {}",
+    "Coroutine task finished: {} Result: {}",
+    "Latency {} ({} runs): wait p50/p99/p999 = {}/{}/{} us, run p50/p99/p999 = {}/{}/{} us, notify p99 = {} us",
+};
+
+static_assert(sizeof(kTemplates) / sizeof(kTemplates[0]) == static_cast<size_t>(LogFmt::Count),
+    "every LogFmt needs a template");
+
+const char* LogFormatTemplate(LogFmt format) {
+    auto index = static_cast<size_t>(format);
+    return index < static_cast<size_t>(LogFmt::Count) ? kTemplates[index] : "{}";
+}
+
+namespace StructuredLog {
+
+bool GetVarint(std::string_view& in, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in.empty()) return false;
+        auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool DecodeArgs(std::string_view payload, std::vector<LogArg>& args) {
+    args.clear();
+    while (!payload.empty()) {
+        LogArg arg;
+        arg.type = static_cast<LogArgType>(payload.front());
+        payload.remove_prefix(1);
+        uint64_t v = 0;
+        switch (arg.type) {
+        case LogArgType::Int:
+            if (!GetVarint(payload, v)) return false;
+            arg.i = UnZigZag(v);
+            break;
+        case LogArgType::UInt:
+        case LogArgType::Name:
+            if (!GetVarint(payload, arg.u)) return false;
+            break;
+        case LogArgType::Double:
+            if (payload.size() < sizeof(double)) return false;
+            std::memcpy(&arg.d, payload.data(), sizeof(double));
+            payload.remove_prefix(sizeof(double));
+            break;
+        case LogArgType::String:
+            if (!GetVarint(payload, v) || v > payload.size()) return false;
+            arg.s = payload.substr(0, static_cast<size_t>(v));
+            payload.remove_prefix(static_cast<size_t>(v));
+            break;
+        default:
+            return false;
+        }
+        args.push_back(arg);
+    }
+    return true;
+}
+
+static void AppendArg(const LogArg& arg, const NameLookup& names, std::string& out) {
+    char buf[32];
+    switch (arg.type) {
+    case LogArgType::Int:
+        std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(arg.i));
+        out += buf;
+        break;
+    case LogArgType::UInt:
+        std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(arg.u));
+        out += buf;
+        break;
+    case LogArgType::Double:
+        std::snprintf(buf, sizeof(buf), "%g", arg.d);
+        out += buf;
+        break;
+    case LogArgType::String:
+        out.append(arg.s);
+        break;
+    case LogArgType::Name:
+        out.append(names(static_cast<uint32_t>(arg.u)));
+        break;
+    }
+}
+
+void Render(std::string_view tmpl, const std::vector<LogArg>& args, const NameLookup& names, std::string& out) {
+    size_t next = 0;
+    size_t pos = 0;
+    while (pos < tmpl.size()) {
+        size_t hole = tmpl.find("{}", pos);
+        if (hole == std::string_view::npos) break;
+        out.append(tmpl.substr(pos, hole - pos));
+        if (next < args.size()) AppendArg(args[next++], names, out);
+        pos = hole + 2;
+    }
+    out.append(tmpl.substr(std::min(pos, tmpl.size())));
+
+    // ռλࣨģĹʱĩβϢ
+    for (; next < args.size(); ++next) {
+        out += ' ';
+        AppendArg(args[next], names, out);
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// ṹ־ʽ + ͱĲдʱŸʽֱдƣ
+// д־ĳ߽빤 LogDecoder ļ
+
+// ģеÿ {} ζӦһֻĩβ׷ӣбŲܸ
+enum class LogFmt : uint16_t {
+    Text = 0,  // WriteLine дĴı
+    SchedulerStarted,
+    TaskSubmitted,
+    TaskCoalesced,
+    ScheduleAfter,
+    ScheduleEvery,
+    TimerCancelled,
+    CancelGroup,
+    WorkerStarted,
+    WorkerGotTask,
+    WorkerStoleTask,
+    WorkerEnded,
+    TaskCancelledBeforeStart,
+    TaskExecuting,
+    TaskCancelledDuringExecution,
+    TaskFailed,
+    TaskSucceeded,
+    TaskCancelledException,
+    TaskUnknownError,
+    TaskCompleted,
+    CoroutineFinished,
+    LatencySummary,
+    Count
+};
+
+const char* LogFormatTemplate(LogFmt format);
+
+//  TaskNames ż¼ÿļһγʱдһƶ
+struct LogName {
+    uint32_t id;
+};
+
+enum class LogArgType : uint8_t { Int = 1, UInt = 2, Double = 3, String = 4, Name = 5 };
+
+struct LogArg {
+    LogArgType type = LogArgType::Int;
+    int64_t i = 0;
+    uint64_t u = 0;  // UInt ֵName ı
+    double d = 0;
+    std::string_view s;
+};
+
+// ļkLogMagic ֮һ¼¼һֽڵ LogRecordTag ͷ
+//   FormatDef: varint , varint , ģ
+//   NameDef:   varint , varint , 
+//   Entry:     varint ʽ, zigzag varint һʱ(ns), varint , 
+// ʽƶļд빤߲Ҫͳͬһ汾
+constexpr char kLogMagic[8] = { 'P', '3', 'S', 'L', 'O', 'G', '\x01', '\n' };
+
+enum class LogRecordTag : uint8_t { FormatDef = 1, NameDef = 2, Entry = 3 };
+
+namespace StructuredLog {
+
+inline void PutVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out += static_cast<char>((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    out += static_cast<char>(v);
+}
+
+inline uint64_t ZigZag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+// ȡʧܣݽضϣʱ false
+bool GetVarint(std::string_view& in, uint64_t& v);
+
+inline void EncodeArg(std::string& out, std::string_view s) {
+    out += static_cast<char>(LogArgType::String);
+    PutVarint(out, s.size());
+    out.append(s);
+}
+
+inline void EncodeArg(std::string& out, const std::string& s) { EncodeArg(out, std::string_view(s)); }
+inline void EncodeArg(std::string& out, const char* s) { EncodeArg(out, std::string_view(s)); }
+
+inline void EncodeArg(std::string& out, LogName name) {
+    out += static_cast<char>(LogArgType::Name);
+    PutVarint(out, name.id);
+}
+
+template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+void EncodeArg(std::string& out, T v) {
+    if constexpr (std::is_floating_point_v<T>) {
+        out += static_cast<char>(LogArgType::Double);
+        char bytes[sizeof(double)];
+        double d = static_cast<double>(v);
+        std::memcpy(bytes, &d, sizeof(bytes));
+        out.append(bytes, sizeof(bytes));
+    }
+    else if constexpr (std::is_signed_v<T>) {
+        out += static_cast<char>(LogArgType::Int);
+        PutVarint(out, ZigZag(static_cast<int64_t>(v)));
+    }
+    else {
+        out += static_cast<char>(LogArgType::UInt);
+        PutVarint(out, static_cast<uint64_t>(v));
+    }
+}
+
+// һ¼Ĳֱַ payload
+bool DecodeArgs(std::string_view payload, std::vector<LogArg>& args);
+
+// ģȾΪınames Ʊת
+using NameLookup = std::function<std::string_view(uint32_t)>;
+void Render(std::string_view tmpl, const std::vector<LogArg>& args, const NameLookup& names, std::string& out);
+
+}
\ No newline at end of file
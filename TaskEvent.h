@@ -1,10 +1,29 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include "TaskNames.h"
+#include "MessagePool.h"
 
 enum class TaskEventType { Started, Succeeded, Failed, Cancelled };
 
+// ¼ֻšʱͳػϢãֵƲڴ棻
+// ƺϢıʾʱٲ
 struct TaskEvent {
-    TaskEventType type;
-    std::string taskName;
-    std::string message;
-};
\ No newline at end of file
+    TaskEventType type = TaskEventType::Started;
+    NameId name = kInvalidName;
+    NameId group = kInvalidName;  // ҲƱţδΪ kInvalidName
+    uint64_t taskId = 0;
+    int64_t timestampNs = 0;  // steady_clock
+    MessageRef message;
+
+    const std::string& Name() const { return TaskNames::Get(name); }
+
+    std::string Message() const {
+        std::string text;
+        if (!MessagePool::AppendTo(message, text) && !message.Empty()) text = MessagePool::kLostText;
+        return text;
+    }
+};
+
+static_assert(std::is_trivially_copyable<TaskEvent>::value, "TaskEvent must stay trivially copyable");
\ No newline at end of file
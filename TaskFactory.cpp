@@ -32,10 +32,34 @@ std::shared_ptr<ITask> TaskFactory::CreateMatrixMultiplyTask() {
     return std::make_shared<MatrixMultiplyTask>();
 }
 
+std::shared_ptr<ITask> TaskFactory::CreateMatrixMultiplyTask(size_t size) {
+    return std::make_shared<MatrixMultiplyTask>(size);
+}
+
+std::shared_ptr<ITask> TaskFactory::CreateMatrixMultiplyTask(MatrixElement element, size_t size) {
+    switch (element) {
+    case MatrixElement::Float: return std::make_shared<BasicMatrixMultiplyTask<float>>(size);
+    case MatrixElement::Int32: return std::make_shared<BasicMatrixMultiplyTask<int32_t>>(size);
+    default:                   return std::make_shared<BasicMatrixMultiplyTask<double>>(size);
+    }
+}
+
+std::shared_ptr<ITask> TaskFactory::CreateSmallMatrixBatchTask(MatrixElement element, size_t size, size_t count) {
+    switch (element) {
+    case MatrixElement::Float: return std::make_shared<SmallMatrixBatchTask<float>>(size, count);
+    case MatrixElement::Int32: return std::make_shared<SmallMatrixBatchTask<int32_t>>(size, count);
+    default:                   return std::make_shared<SmallMatrixBatchTask<double>>(size, count);
+    }
+}
+
 std::shared_ptr<ITask> TaskFactory::CreateHttpGetTask() {
     return std::make_shared<HttpGetZenTask>(std::filesystem::current_path() / "zen.txt");
 }
 
 std::shared_ptr<ITask> TaskFactory::CreateRandomStatsTask() {
     return std::make_shared<RandomStatsTask>();
+}
+
+std::shared_ptr<ITask> TaskFactory::CreateRandomStatsTask(uint64_t count) {
+    return std::make_shared<RandomStatsTask>(count);
 }
\ No newline at end of file
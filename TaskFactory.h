@@ -1,12 +1,21 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <filesystem>
 #include "ITask.h"
+#include "MatrixMultiply.h"
 
 class TaskFactory {
 public:
     static std::shared_ptr<ITask> CreateFileBackupTask();
     static std::shared_ptr<ITask> CreateMatrixMultiplyTask();
+    static std::shared_ptr<ITask> CreateMatrixMultiplyTask(size_t size);
+    // Ԫѡsize Ϊ 8/16/32/64 ʱչںˣ߷ֿ·У
+    static std::shared_ptr<ITask> CreateMatrixMultiplyTask(MatrixElement element, size_t size);
+    // Сһ count  size x size ˷size Ϊ 8/16/32/64
+    static std::shared_ptr<ITask> CreateSmallMatrixBatchTask(MatrixElement element, size_t size, size_t count);
     static std::shared_ptr<ITask> CreateHttpGetTask();
     static std::shared_ptr<ITask> CreateRandomStatsTask();
+    // count ʽͳƣڴռ count ޹
+    static std::shared_ptr<ITask> CreateRandomStatsTask(uint64_t count);
 };
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "TaskGraph.h"
+#include "TaskScheduler.h"
+#include <stdexcept>
+
+namespace {
+
+// ǰ߳ Drain ͼĹб뿪ʱָ
+struct DrainScope;
+thread_local DrainScope* tlsDrain = nullptr;
+
+struct DrainScope {
+    const void* owner;
+    std::vector<size_t>* ready;
+    DrainScope* outer;
+
+    DrainScope(const void* o, std::vector<size_t>* r) : owner(o), ready(r), outer(tlsDrain) { tlsDrain = this; }
+    ~DrainScope() { tlsDrain = outer; }
+    DrainScope(const DrainScope&) = delete;
+    DrainScope& operator=(const DrainScope&) = delete;
+};
+
+}
+
+TaskGraph::TaskGraph() : impl_(std::make_shared<Impl>()) {
+}
+
+TaskGraph::NodeId TaskGraph::Add(std::shared_ptr<ITask> task, const std::vector<NodeId>& deps) {
+    if (submitted_) {
+        throw std::logic_error("TaskGraph::Add after Submit");
+    }
+
+    NodeId id = impl_->nodes.size();
+    for (NodeId dep : deps) {
+        if (dep >= id) {
+            throw std::out_of_range("TaskGraph::Add: unknown dependency");
+        }
+    }
+
+    auto node = std::make_unique<Node>();
+    node->task = std::move(task);
+    node->predecessors = deps.size();
+    impl_->nodes.push_back(std::move(node));
+    for (NodeId dep : deps) {
+        impl_->nodes[dep]->successors.push_back(id);
+    }
+    return id;
+}
+
+void TaskGraph::Submit(TaskScheduler& scheduler) {
+    if (submitted_) return;
+    submitted_ = true;
+
+    impl_->scheduler = &scheduler;
+    {
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        impl_->remaining = impl_->nodes.size();
+    }
+    for (auto& node : impl_->nodes) {
+        node->pending = node->predecessors;
+    }
+
+    // ռڵ㣬ڵܿɺ޸ pending ظύ
+    std::vector<NodeId> roots;
+    for (NodeId id = 0; id < impl_->nodes.size(); ++id) {
+        if (impl_->nodes[id]->predecessors == 0) roots.push_back(id);
+    }
+    impl_->Drain(std::move(roots));
+}
+
+void TaskGraph::Cancel(NodeId node) {
+    if (node >= impl_->nodes.size()) return;
+    impl_->CancelFrom(node);
+}
+
+void TaskGraph::CancelAll() {
+    for (NodeId id = 0; id < impl_->nodes.size(); ++id) {
+        impl_->CancelFrom(id);
+    }
+}
+
+void TaskGraph::Wait() const {
+    std::unique_lock<std::mutex> lk(impl_->mtx);
+    impl_->cv.wait(lk, [&]() { return impl_->remaining == 0; });
+}
+
+TaskResult TaskGraph::Result(NodeId node) const {
+    if (node >= impl_->nodes.size()) {
+        return TaskResult::Failure("Unknown graph node");
+    }
+    std::lock_guard<std::mutex> lk(impl_->mtx);
+    return impl_->nodes[node]->result;
+}
+
+void TaskGraph::Impl::Drain(std::vector<NodeId> ready) {
+    // ߳Ѿڴͼ Then ɵľͬصѭ
+    if (tlsDrain && tlsDrain->owner == this) {
+        tlsDrain->ready->insert(tlsDrain->ready->end(), ready.begin(), ready.end());
+        return;
+    }
+
+    DrainScope scope(this, &ready);
+    auto self = shared_from_this();
+
+    while (!ready.empty()) {
+        NodeId id = ready.back();
+        ready.pop_back();
+
+        Node& node = *nodes[id];
+        if (node.cancelled) {
+            Settle(id, TaskResult::Cancelled("Cancelled: predecessor failed or cancelled"), ready);
+            continue;
+        }
+
+        TaskHandle handle = scheduler->ExecuteImmediately(node.task);
+        if (!handle.IsValid()) {
+            Settle(id, TaskResult::Failure("Graph node error: scheduler not running"), ready);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            node.handle = handle;
+        }
+        // Cancel() ύǰ֮䷢
+        if (node.cancelled) handle.Cancel();
+
+        handle.Then([self, id](const TaskResult& r) { self->Finish(id, r); });
+    }
+}
+
+void TaskGraph::Impl::Finish(NodeId id, const TaskResult& result) {
+    std::vector<NodeId> ready;
+    Settle(id, result, ready);
+    if (!ready.empty()) Drain(std::move(ready));
+}
+
+void TaskGraph::Impl::Settle(NodeId id, const TaskResult& result, std::vector<NodeId>& ready) {
+    Node& node = *nodes[id];
+    if (node.finished.exchange(true)) return;
+
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        node.result = result;
+    }
+
+    // һǰɵ̸߳ύ
+    for (NodeId succ : node.successors) {
+        Node& next = *nodes[succ];
+        if (result.status != TaskStatus::Succeeded) {
+            next.cancelled = true;
+        }
+        if (next.pending.fetch_sub(1) == 1) {
+            ready.push_back(succ);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (--remaining == 0) cv.notify_all();
+    }
+}
+
+void TaskGraph::Impl::CancelFrom(NodeId id) {
+    std::vector<NodeId> stack{ id };
+    while (!stack.empty()) {
+        NodeId cur = stack.back();
+        stack.pop_back();
+
+        Node& node = *nodes[cur];
+        if (node.cancelled.exchange(true)) continue;
+
+        TaskHandle handle;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            handle = node.handle;
+        }
+        handle.Cancel();
+
+        for (NodeId succ : node.successors) stack.push_back(succ);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ITask.h"
+#include "TaskHandle.h"
+
+class TaskScheduler;
+
+// ͼDAG
+// ڵһǰʱĹֱ߳ύûмѯ
+// ǰʧܻȡʱк̽ڵ Cancelled ִ
+class TaskGraph {
+public:
+    using NodeId = size_t;
+
+    TaskGraph();
+
+    // deps ֻӵĽڵ㣬ͼȻ޻
+    NodeId Add(std::shared_ptr<ITask> task, const std::vector<NodeId>& deps = {});
+
+    // ύûǰĽڵ㣻ÿͼֻύһ
+    void Submit(TaskScheduler& scheduler);
+
+    // ȡڵ㼰к
+    void Cancel(NodeId node);
+    void CancelAll();
+
+    void Wait() const;
+    template <class Rep, class Period>
+    bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        std::unique_lock<std::mutex> lk(impl_->mtx);
+        return impl_->cv.wait_for(lk, timeout, [&]() { return impl_->remaining == 0; });
+    }
+
+    size_t Size() const { return impl_->nodes.size(); }
+    // ڵǰ Succeeded Ϳ
+    TaskResult Result(NodeId node) const;
+
+private:
+    struct Node {
+        std::shared_ptr<ITask> task;
+        std::vector<NodeId> successors;
+        size_t predecessors = 0;
+        std::atomic<size_t> pending{ 0 };
+        std::atomic<bool> cancelled{ false };
+        std::atomic<bool> finished{ false };
+        TaskHandle handle;   //  Impl::mtx 
+        TaskResult result;   //  Impl::mtx 
+    };
+
+    struct Impl : std::enable_shared_from_this<Impl> {
+        std::vector<std::unique_ptr<Node>> nodes;
+        TaskScheduler* scheduler = nullptr;
+
+        mutable std::mutex mtx;
+        mutable std::condition_variable cv;
+        size_t remaining = 0;
+
+        // ύ ready еĽڵ㣻ͬĽڵѺ׷ӵͬһб
+        // ջȲ
+        void Drain(std::vector<NodeId> ready);
+        void Finish(NodeId id, const TaskResult& result);
+        // ¼Ѿĺ̷ readyύ
+        void Settle(NodeId id, const TaskResult& result, std::vector<NodeId>& ready);
+        void CancelFrom(NodeId id);
+    };
+
+    std::shared_ptr<Impl> impl_;
+    bool submitted_ = false;
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ITask.h"
+#include "TaskResult.h"
+#include "QueuePolicy.h"
+#include "LatencyHistogram.h"
+
+// һύڵڲ״̬бľ
+struct TaskState {
+    uint64_t id = 0;
+    std::shared_ptr<ITask> task;
+    NameId nameId = kInvalidName;
+    CancellationTokenPtr token = CancellationTokenPool::Acquire();
+
+    std::string group;              // Ϊձʾκη
+    NameId groupId = kInvalidName;  // group ıţ¼ͶĹ
+    std::string coalesceKey;        // Ϊձʾϲ
+    std::atomic<uint32_t> submitters{ 0 };  // ϲִδصύ 0 ʱȡִ
+    TaskPriority priority = TaskPriority::Normal;
+    std::coroutine_handle<> coroutine;  // ЭʼУ״̬һ
+    uint64_t cancelEpoch = 0;       // ύʱ CancelAll 
+    uint64_t deadlineTimer = 0;     // ֹʱ䶨ʱ0 ʾû
+    std::atomic<bool> deadlineExpired{ false };
+    std::atomic<bool> finishing{ false };  // FinishState ѽֻ֣һ
+
+    // ʱͳƣύʼʱ͸͵ֱͼ
+    std::chrono::steady_clock::time_point submittedAt;
+    std::chrono::steady_clock::time_point startedAt;
+    TaskLatency* latency = nullptr;
+
+    using Continuation = std::function<void(const TaskResult&)>;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool done = false;
+    TaskResult result;
+    std::vector<Continuation> continuations;
+
+    ~TaskState() {
+        if (coroutine) coroutine.destroy();
+    }
+
+    // ֻеһЧʱ falseͺٱ䶯
+    bool Complete(TaskResult r) {
+        std::vector<Continuation> conts;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (done) return false;
+            result = std::move(r);
+            done = true;
+            conts.swap(continuations);
+        }
+        cv.notify_all();
+
+        // ֱ߳кҪѯ
+        for (auto& c : conts) c(result);
+        return true;
+    }
+
+    // ʱڵǰ̵߳
+    void OnComplete(Continuation c) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (!done) {
+                continuations.push_back(std::move(c));
+                return;
+            }
+        }
+        c(result);
+    }
+};
+
+using TaskStatePtr = std::shared_ptr<TaskState>;
+
+// ύ󷵻ظ÷ľԵȴȡ
+class TaskHandle {
+public:
+    TaskHandle() = default;
+    explicit TaskHandle(TaskStatePtr state) : state_(std::move(state)) {}
+
+    bool IsValid() const { return state_ != nullptr; }
+    uint64_t Id() const { return state_ ? state_->id : 0; }
+
+    bool IsDone() const {
+        if (!state_) return true;
+        std::lock_guard<std::mutex> lk(state_->mtx);
+        return state_->done;
+    }
+
+    void Wait() const {
+        if (!state_) return;
+        std::unique_lock<std::mutex> lk(state_->mtx);
+        state_->cv.wait(lk, [&]() { return state_->done; });
+    }
+
+    template <class Rep, class Period>
+    bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        if (!state_) return true;
+        std::unique_lock<std::mutex> lk(state_->mtx);
+        return state_->cv.wait_for(lk, timeout, [&]() { return state_->done; });
+    }
+
+    // ȡŶе񲻻ִУеͨƸ֪
+    // ϲύľֻԼһύύغȡõִ
+    void Cancel() const {
+        if (state_) state_->token->Cancel();
+    }
+
+    // ߳ϵ fn
+    void Then(TaskState::Continuation fn) const {
+        if (state_) state_->OnComplete(std::move(fn));
+    }
+
+    // ֱЧ Failed
+    const TaskResult& Get() const {
+        static const TaskResult invalid{ TaskStatus::Failed, "Invalid task handle" };
+        if (!state_) return invalid;
+        Wait();
+        return state_->result;
+    }
+
+private:
+    TaskStatePtr state_;
+};
\ No newline at end of file
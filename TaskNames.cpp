@@ -0,0 +1,66 @@
+#include "TaskNames.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// ưţһͲƶʱҪ
+constexpr size_t kChunkBits = 10;
+constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+constexpr size_t kMaxChunks = 1024;  // Լһͬ
+
+struct Registry {
+    std::mutex mtx;
+    std::unordered_map<std::string_view, NameId> ids;  // ָбַ
+    std::atomic<std::string*> chunks[kMaxChunks] = {};
+    std::atomic<NameId> count{ 1 };  //  0 
+};
+
+Registry& Instance() {
+    // ⲻ̬Կ̲߳
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+const std::string& Empty() {
+    static const std::string* empty = new std::string();
+    return *empty;
+}
+
+}  // namespace
+
+NameId TaskNames::Intern(std::string_view name) {
+    Registry& r = Instance();
+    std::lock_guard<std::mutex> lk(r.mtx);
+
+    auto it = r.ids.find(name);
+    if (it != r.ids.end()) return it->second;
+
+    NameId id = r.count.load(std::memory_order_relaxed);
+    size_t chunk = id >> kChunkBits;
+    if (chunk >= kMaxChunks) return kInvalidName;
+
+    std::string* block = r.chunks[chunk].load(std::memory_order_relaxed);
+    if (!block) {
+        block = new std::string[kChunkSize];
+        r.chunks[chunk].store(block, std::memory_order_release);
+    }
+    std::string& slot = block[id & (kChunkSize - 1)];
+    slot.assign(name.data(), name.size());
+    r.ids.emplace(std::string_view(slot), id);
+
+    // дַٹ
+    r.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const std::string& TaskNames::Get(NameId id) {
+    Registry& r = Instance();
+    if (id == kInvalidName || id >= r.count.load(std::memory_order_acquire)) {
+        return Empty();
+    }
+    std::string* block = r.chunks[id >> kChunkBits].load(std::memory_order_acquire);
+    return block[id & (kChunkSize - 1)];
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// פƱţ0 ʾЧ
+using NameId = uint32_t;
+constexpr NameId kInvalidName = 0;
+
+// פֻͬһݣֻ֮ݱ
+class TaskNames {
+public:
+    // Ǽʱʱ kInvalidName
+    static NameId Intern(std::string_view name);
+
+    // ңصһֱЧδ֪ŷؿַ
+    static const std::string& Get(NameId id);
+};
\ No newline at end of file
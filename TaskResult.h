@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <utility>
+
+// Rejectedύûִ
+enum class TaskStatus { Succeeded, Failed, Cancelled, Rejected };
+
+// ִнʽ״̬ + ƶĽ
+struct TaskResult {
+    TaskStatus status = TaskStatus::Succeeded;
+    std::string payload;
+
+    static TaskResult Success(std::string payload) {
+        return { TaskStatus::Succeeded, std::move(payload) };
+    }
+    static TaskResult Failure(std::string payload) {
+        return { TaskStatus::Failed, std::move(payload) };
+    }
+    static TaskResult Cancelled(std::string payload) {
+        return { TaskStatus::Cancelled, std::move(payload) };
+    }
+    static TaskResult Rejected(std::string payload) {
+        return { TaskStatus::Rejected, std::move(payload) };
+    }
+
+    // ַֻԭĹؼж
+    static TaskResult FromLegacy(std::string result) {
+        if (!result.empty() && result.find("cancelled") != std::string::npos) {
+            return Cancelled(std::move(result));
+        }
+        if (result.empty()) {
+            return Failure("Unknown error");
+        }
+        if (result.find("error") != std::string::npos || result.find("Error") != std::string::npos) {
+            return Failure(std::move(result));
+        }
+        return Success(std::move(result));
+    }
+};
\ No newline at end of file
@@ -1,26 +1,66 @@
 #include "TaskScheduler.h"
+#include "TraceRecorder.h"
 #include <chrono>
 #include <sstream>
 #include <iostream>
+#include <map>
+#include <algorithm>
 
 TaskScheduler& TaskScheduler::Instance() {
     static TaskScheduler inst;
     return inst;
 }
 
-void TaskScheduler::Start(std::shared_ptr<LogWriter> logger) {
+static int64_t SteadyNs(TaskScheduler::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+// ǰ߳Ḷ́߳ǹ߳Ϊ nullptr
+static thread_local TaskScheduler* tlsScheduler = nullptr;
+static thread_local size_t tlsWorkerIndex = 0;
+// ʱֹ̣߳ʱ Delay Ѷύʱ
+static thread_local bool tlsTimerThread = false;
+
+void TaskScheduler::Start(std::shared_ptr<LogWriter> logger, size_t workerCount, const QueueOptions& queue,
+    const EventBusOptions& events) {
     std::lock_guard<std::mutex> lk(mtx_);
     if (running_) return;
 
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+        if (workerCount == 0) workerCount = 1;
+    }
+
     logger_ = std::move(logger);
+    workers_.clear();
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    workerCount_ = workerCount;
+    queueOptions_ = queue;
+    if (queueOptions_.capacity == 0) queueOptions_.capacity = 1;
+    for (auto& lane : lanes_) {
+        lane = std::make_unique<BoundedQueue<TaskStatePtr>>(queueOptions_.capacity);
+    }
+    pending_ = 0;
+    startedAt_ = Clock::now();
+    if (events.capacity > MessagePool::kSlots / 2 && logger_) {
+        // Ŷе¼ѱǵϢλʧϢ MessagePool::Lost()
+        logger_->WriteLine("Event ring capacity " + std::to_string(events.capacity)
+            + " exceeds half of the message pool, event messages may be lost");
+    }
+    events_.Start(events, [this](std::vector<TaskEvent>& batch) { DispatchEvents(batch); });
     running_ = true;
-    worker_ = std::thread(&TaskScheduler::WorkerThread, this);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread(&TaskScheduler::WorkerThread, this, i);
+    }
+    timerThread_ = std::thread(&TaskScheduler::TimerThread, this);
 
     // 
     if (logger_) {
-        logger_->WriteLine("TaskScheduler started");
+        logger_->Log(LogFmt::SchedulerStarted, workerCount);
     }
-    std::cout << "TaskScheduler started" << std::endl;
+    std::cout << "TaskScheduler started with " << workerCount << " workers" << std::endl;
 }
 
 void TaskScheduler::Stop() {
@@ -30,25 +70,106 @@ void TaskScheduler::Stop() {
         running_ = false;
     }
 
-    cv_.notify_all();
+    parker_.NotifyAll();
+    {
+        std::lock_guard<std::mutex> lk(timerMtx_);
+    }
+    timerCv_.notify_all();
+    {
+        std::lock_guard<std::mutex> lk(spaceMtx_);
+    }
+    spaceCv_.notify_all();
 
-    if (worker_.joinable()) {
-        worker_.join();
+    if (timerThread_.joinable()) {
+        timerThread_.join();
     }
 
+    // еЭֻʱ I/O صУնʱ֮ǰȡȴĵ÷ԶȲ
+    std::vector<TaskStatePtr> suspended;
+    {
+        std::lock_guard<std::mutex> lk(coMtx_);
+        for (auto& kv : coroutines_) {
+            if (auto s = kv.second.lock()) suspended.push_back(std::move(s));
+        }
+        coroutines_.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lk(timerMtx_);
+        timers_.Clear();
+        timerWakeAt_ = Clock::time_point::max();
+    }
+
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+
+    // ȡƻùĻص Resumeֹͣʱֱӽٶһ
+    // Ҫȡ֮ǰû
+    size_t abandoned = 0;
+    for (auto& s : suspended) {
+        if (!s->finishing.load(std::memory_order_acquire)) ++abandoned;
+        s->token->Cancel();
+        FinishState(s, TaskResult::Cancelled("Cancelled: scheduler stopped"));
+    }
+    suspended.clear();
+
+    // δִе Rejected ȴĵ÷ͺһֱ
+    std::vector<TaskStatePtr> queued;
+    for (auto& w : workers_) {
+        std::lock_guard<std::mutex> lk(w->mtx);
+        for (auto& s : w->tasks) queued.push_back(std::move(s));
+        w->tasks.clear();
+    }
+    // ȡվͣռ˲λûдʱ TryPop ʱʧܣдõ©ˣ
+    // pending_ ǰռ˵Ӷȡ
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        if (auto s = PopLanes()) queued.push_back(std::move(s));
+        else std::this_thread::yield();
+    }
+    {
+        // ϲһҲڶУFinishState Ƴϲ
+        std::lock_guard<std::mutex> lk(coalesceMtx_);
+        for (auto& kv : coalescing_) {
+            if (std::find(queued.begin(), queued.end(), kv.second) == queued.end()) queued.push_back(kv.second);
+        }
+    }
+    size_t dropped = 0;
+    for (auto& s : queued) {
+        if (FinishState(s, TaskResult::Rejected("Rejected: scheduler stopped"))) ++dropped;
+    }
+    queued.clear();
+
+    // ̶߳˳ʣ¼ַַͣ߳
+    events_.Stop();
+
     // 
     if (logger_) {
-        logger_->WriteLine("TaskScheduler stopped");
+        logger_->WriteLine("TaskScheduler stopped, dropped " + std::to_string(dropped) + " queued tasks, "
+            + std::to_string(abandoned) + " suspended coroutines, " + std::to_string(events_.Dropped()) + " events, "
+            + std::to_string(MessagePool::Lost()) + " lost messages");
     }
     std::cout << "TaskScheduler stopped" << std::endl;
+
+    // ÿĺʱֲд־λ΢
+    if (logger_) {
+        auto us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        for (const auto& r : latency_.Report()) {
+            if (r.run.count == 0) continue;
+            logger_->Log(LogFmt::LatencySummary, r.name, r.run.count,
+                us(r.queueWait.p50Ns), us(r.queueWait.p99Ns), us(r.queueWait.p999Ns),
+                us(r.run.p50Ns), us(r.run.p99Ns), us(r.run.p999Ns), us(r.notify.p99Ns));
+        }
+    }
 }
 
-void TaskScheduler::ExecuteImmediately(std::shared_ptr<ITask> task) {
+TaskHandle TaskScheduler::ExecuteImmediately(std::shared_ptr<ITask> task, const SubmitOptions& options) {
     if (!task) {
         if (logger_) {
             logger_->WriteLine("ExecuteImmediately: null task provided");
         }
-        return;
+        return TaskHandle();
     }
 
     if (!running_) {
@@ -56,225 +177,1097 @@ void TaskScheduler::ExecuteImmediately(std::shared_ptr<ITask> task) {
             logger_->WriteLine("ExecuteImmediately called but scheduler not running: " + task->GetName());
         }
         std::cout << "ExecuteImmediately: scheduler not running for " << task->GetName() << std::endl;
-        return;
+        return TaskHandle();
+    }
+
+    const std::string& name = TaskNames::Get(task->GetNameId());
+    bool attached = false;
+    TaskStatePtr submission;
+    auto state = MakeOrAttach(std::move(task), options, attached, submission);
+    TaskHandle handle(std::move(submission));
+
+    if (attached) {
+        // 
+        if (logger_) {
+            logger_->Log(LogFmt::TaskCoalesced, LogName{ state->nameId }, state->id);
+        }
+        if (ConsoleOutput()) std::cout << "ExecuteImmediately: " << name << " coalesced into task #" << state->id << std::endl;
+        return handle;
     }
 
     // 
     if (logger_) {
-        logger_->WriteLine("ExecuteImmediately: " + task->GetName());
+        logger_->Log(LogFmt::TaskSubmitted, LogName{ state->nameId });
+    }
+    if (ConsoleOutput()) std::cout << "ExecuteImmediately: " << name << std::endl;
+
+    if (Enqueue(std::move(state))) {
+        parker_.NotifyOne();  // ֻй߳ʱ
     }
-    std::cout << "ExecuteImmediately: " << task->GetName() << std::endl;
+    return handle;
+}
+
+std::vector<TaskHandle> TaskScheduler::ExecuteBatch(std::vector<std::shared_ptr<ITask>> tasks,
+    const SubmitOptions& options) {
+    std::vector<TaskHandle> handles;
+
+    if (!running_) {
+        if (logger_) {
+            logger_->WriteLine("ExecuteBatch called but scheduler not running: "
+                + std::to_string(tasks.size()) + " tasks");
+        }
+        std::cout << "ExecuteBatch: scheduler not running" << std::endl;
+        handles.resize(tasks.size());
+        return handles;
+    }
+
+    std::vector<TaskStatePtr> states;
+    states.reserve(tasks.size());
+    handles.reserve(tasks.size());
+    std::map<std::string, size_t> counts;
+    size_t coalesced = 0;
+    for (auto& task : tasks) {
+        if (!task) {
+            // ռһЧhandles[i] ʼնӦ tasks[i]
+            handles.emplace_back();
+            continue;
+        }
+        bool attached = false;
+        const std::string& name = TaskNames::Get(task->GetNameId());
+        TaskStatePtr submission;
+        auto state = MakeOrAttach(std::move(task), options, attached, submission);
+        handles.emplace_back(std::move(submission));
+        if (attached) {
+            ++coalesced;
+            continue;
+        }
+        ++counts[name];
+        states.push_back(std::move(state));
+    }
+    if (states.empty() && coalesced == 0) return handles;
+
+    // һ־־
+    std::ostringstream oss;
+    oss << "ExecuteBatch: " << states.size() << " tasks";
+    for (const auto& kv : counts) {
+        oss << " [" << kv.first << " x" << kv.second << "]";
+    }
+    if (coalesced > 0) {
+        oss << ", " << coalesced << " coalesced";
+    }
+    if (logger_) {
+        logger_->WriteLine(oss.str());
+    }
+    if (ConsoleOutput()) std::cout << oss.str() << std::endl;
+
+    size_t admitted = 0;
+    if (tlsScheduler == this) {
+        Worker& w = *workers_[tlsWorkerIndex];
+        std::lock_guard<std::mutex> lk(w.mtx);
+        for (auto& s : states) w.tasks.push_back(std::move(s));
+        admitted = states.size();
+    }
+    else {
+        for (auto& s : states) {
+            if (Enqueue(std::move(s))) ++admitted;
+        }
+    }
+
+    parker_.NotifyMany(admitted);
+    return handles;
+}
+
+TaskStatePtr TaskScheduler::MakeState(std::shared_ptr<ITask> task, const SubmitOptions& options) {
+    auto state = std::make_shared<TaskState>();
+    state->id = nextTaskId_.fetch_add(1, std::memory_order_relaxed);
+    state->nameId = task->GetNameId();
+    state->submittedAt = Clock::now();
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    state->latency = latency_.Get(state->nameId);
+    if (TraceRecorder::Enabled()) {
+        TraceRecorder::Instant(TraceKind::Enqueue, state->nameId, state->id, state->submittedAt);
+    }
+    state->task = std::move(task);
+    state->cancelEpoch = cancelEpoch_.load(std::memory_order_acquire);
+    state->priority = options.priority;
+
+    if (!options.group.empty()) {
+        state->group = options.group;
+        state->groupId = TaskNames::Intern(options.group);
+        std::lock_guard<std::mutex> lk(groupMtx_);
+        auto& list = groups_[options.group];
+        // ʱ˳Ѿͷŵ
+        if (list.size() >= 64 && (list.size() & (list.size() - 1)) == 0) {
+            list.erase(std::remove_if(list.begin(), list.end(),
+                [](const std::weak_ptr<TaskState>& w) { return w.expired(); }), list.end());
+        }
+        list.push_back(state);
+    }
+
+    if (options.timeout > Clock::duration::zero()) {
+        std::weak_ptr<TaskState> weak = state;
+        state->deadlineTimer = AddTimer(Clock::now() + options.timeout, [weak]() {
+            if (auto s = weak.lock()) {
+                s->deadlineExpired = true;
+                s->token->Cancel();
+            }
+        }, Clock::duration::zero(), MissedPeriodPolicy::Skip);
+    }
+    return state;
+}
+
+TaskStatePtr TaskScheduler::MakeOrAttach(std::shared_ptr<ITask> task, const SubmitOptions& options, bool& attached,
+    TaskStatePtr& submission) {
+    attached = false;
+    std::string key = task->GetCoalescingKey();
+    if (key.empty()) {
+        submission = MakeState(std::move(task), options);
+        return submission;
+    }
+
+    // 顢ֹʱȼͬύһִУ CancelGroup ͽֹʱԺ߲
+    key += '\x1f';
+    key += options.group;
+    key += '\x1f';
+    key += std::to_string(options.timeout.count());
+    key += '\x1f';
+    key += std::to_string(static_cast<int>(options.priority));
+
+    std::lock_guard<std::mutex> lk(coalesceMtx_);
+    TaskStatePtr state;
+    auto it = coalescing_.find(key);
+    // ύѳصִȡٽµύ
+    if (it != coalescing_.end() && !it->second->token->IsCancelled()) {
+        attached = true;
+        state = it->second;
+    }
+    else {
+        state = MakeState(std::move(task), options);
+        state->coalesceKey = key;
+        coalescing_[std::move(key)] = state;
+    }
+    submission = MakeSubmission(state);
+    return state;
+}
+
+TaskStatePtr TaskScheduler::MakeSubmission(const TaskStatePtr& shared) {
+    // ÿύԼ״̬ƣ湲õִУȡֻһύ
+    auto sub = std::make_shared<TaskState>();
+    sub->id = shared->id;
+    sub->nameId = shared->nameId;
+    sub->group = shared->group;
+    sub->groupId = shared->groupId;
+    sub->priority = shared->priority;
+    sub->submittedAt = Clock::now();
+    shared->submitters.fetch_add(1, std::memory_order_relaxed);
+
+    std::weak_ptr<TaskState> weakSub = sub;
+    std::weak_ptr<TaskState> weakShared = shared;
+    sub->token->Register([weakSub, weakShared]() {
+        auto s = weakSub.lock();
+        if (!s || !s->Complete(TaskResult::Cancelled("Cancelled by user or TaskD"))) return;
+        auto sh = weakShared.lock();
+        if (sh && sh->submitters.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            sh->token->Cancel();
+        }
+    });
+    shared->OnComplete([sub](const TaskResult& r) { sub->Complete(r); });
+    return sub;
+}
+
+bool TaskScheduler::FinishState(const TaskStatePtr& state, TaskResult result) {
+    // ͬһ״̬ܱ෽ύ Stop ͬʱֻܾеһЧ
+    if (state->finishing.exchange(true, std::memory_order_acq_rel)) return false;
+
+    // ڻѵȴ֮ǰƳϲ֮ͬύִ
+    if (!state->coalesceKey.empty()) {
+        std::lock_guard<std::mutex> lk(coalesceMtx_);
+        auto it = coalescing_.find(state->coalesceKey);
+        if (it != coalescing_.end() && it->second == state) {
+            coalescing_.erase(it);
+        }
+    }
+
+    // ѽֹʱ䶨ʱҪ
+    if (state->deadlineTimer != TimerWheel::kInvalidTimer) {
+        std::lock_guard<std::mutex> lk(timerMtx_);
+        timers_.Cancel(state->deadlineTimer);
+    }
+    switch (result.status) {
+    case TaskStatus::Succeeded: succeeded_.fetch_add(1, std::memory_order_relaxed); break;
+    case TaskStatus::Failed:    failed_.fetch_add(1, std::memory_order_relaxed); break;
+    case TaskStatus::Cancelled: cancelled_.fetch_add(1, std::memory_order_relaxed); break;
+    case TaskStatus::Rejected:  rejected_.fetch_add(1, std::memory_order_relaxed); break;
+    }
+    return state->Complete(std::move(result));
+}
 
+bool TaskScheduler::Enqueue(TaskStatePtr state) {
+    // ߳ύԼĶУ߳̿ܵⲿύ
+    if (tlsScheduler == this) {
+        Worker& w = *workers_[tlsWorkerIndex];
+        std::lock_guard<std::mutex> lk(w.mtx);
+        w.tasks.push_back(std::move(state));
+        return true;
+    }
+
+    const size_t capacity = queueOptions_.capacity;
+    bool blockReported = false;
+    for (;;) {
+        // ռӣ֤Ŷ
+        size_t n = pending_.load();
+        if (n < capacity) {
+            if (pending_.compare_exchange_weak(n, n + 1)) {
+                TaskStatePtr queued = state;
+                PushLane(queued);
+                //  Stop ʱпѾգύٱȡ Resume һֱӽ
+                if (!running_) {
+                    FinishState(state, TaskResult::Rejected("Rejected: scheduler stopped"));
+                    return false;
+                }
+                return true;
+            }
+            continue;
+        }
+
+        switch (queueOptions_.policy) {
+        case OverflowPolicy::Block: {
+            if (tlsTimerThread) {
+                // ʱ߳ýֹʱ䲻ٴռŹ̵߳Զ
+                // Эָ̻һֱӷŽ߳ԼĶУ
+                if (PushToWorker(state)) return true;
+                FinishState(state, TaskResult::Rejected("Rejected: scheduler stopped"));
+                return false;
+            }
+            if (!blockReported) {
+                blockReported = true;
+                NotifyQueueFull({ QueueFullAction::Blocked, state->nameId, state->priority,
+                    queueOptions_.policy, capacity, state->groupId });
+            }
+            // ύʱǰܻûлѹ߳
+            parker_.NotifyAll();
+            {
+                std::unique_lock<std::mutex> lk(spaceMtx_);
+                blockedProducers_.fetch_add(1);
+                spaceCv_.wait(lk, [&]() { return pending_.load() < capacity || !running_; });
+                blockedProducers_.fetch_sub(1);
+            }
+            if (!running_) {
+                FinishState(state, TaskResult::Rejected("Rejected: scheduler stopped"));
+                return false;
+            }
+            break;
+        }
+        case OverflowPolicy::Reject:
+            Reject(state, QueueFullAction::Rejected, "Rejected: queue full");
+            return false;
+        case OverflowPolicy::DropOldest:
+        case OverflowPolicy::ShedByPriority: {
+            TaskStatePtr victim = PopVictim(state->priority);
+            if (!victim) {
+                Reject(state, QueueFullAction::Rejected, "Rejected: queue full");
+                return false;
+            }
+            Reject(victim, QueueFullAction::Dropped, "Dropped: queue full");
+            break;
+        }
+        }
+    }
+}
+
+bool TaskScheduler::PushLane(TaskStatePtr& state) {
+    // ռбֻȴͷŲλ
+    auto& lane = *lanes_[static_cast<size_t>(state->priority)];
+    while (!lane.TryPush(state)) {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+TaskStatePtr TaskScheduler::PopLanes() {
+    TaskStatePtr state;
+    for (auto& lane : lanes_) {
+        if (lane && lane->TryPop(state)) {
+            pending_.fetch_sub(1);
+            // ύڵȿλʱ
+            if (blockedProducers_.load() > 0) {
+                std::lock_guard<std::mutex> lk(spaceMtx_);
+                spaceCv_.notify_one();
+            }
+            return state;
+        }
+    }
+    return nullptr;
+}
+
+TaskStatePtr TaskScheduler::PopVictim(TaskPriority incoming) {
+    TaskStatePtr victim;
+    const size_t in = static_cast<size_t>(incoming);
+
+    if (queueOptions_.policy == OverflowPolicy::DropOldest && lanes_[in]->TryPop(victim)) {
+        pending_.fetch_sub(1);
+        return victim;
+    }
+
+    // ȼʼңȼʱֻ͵
+    const size_t stop = queueOptions_.policy == OverflowPolicy::ShedByPriority ? in + 1 : 0;
+    for (size_t i = kTaskPriorityCount; i-- > stop;) {
+        if (lanes_[i]->TryPop(victim)) {
+            pending_.fetch_sub(1);
+            return victim;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::Reject(const TaskStatePtr& state, QueueFullAction action, const char* message) {
+    if (TraceRecorder::Enabled()) {
+        TraceRecorder::Instant(TraceKind::Reject, state->nameId, state->id, Clock::now());
+    }
+    NotifyQueueFull({ action, state->nameId, state->priority, queueOptions_.policy,
+        queueOptions_.capacity, state->groupId });
+    FinishState(state, TaskResult::Rejected(message));
+}
+
+TaskScheduler::TimerId TaskScheduler::ScheduleAfter(Clock::duration delay, std::shared_ptr<ITask> task) {
+    if (!task) {
+        if (logger_) {
+            logger_->WriteLine("ScheduleAfter: null task provided");
+        }
+        return TimerWheel::kInvalidTimer;
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count();
+    if (logger_) {
+        logger_->Log(LogFmt::ScheduleAfter, LogName{ task->GetNameId() }, ms);
+    }
+    std::cout << "ScheduleAfter: " << task->GetName() << " in " << ms << "ms" << std::endl;
+
+    return AddTimer(Clock::now() + delay,
+        [this, task]() { ExecuteImmediately(task); },
+        Clock::duration::zero(), MissedPeriodPolicy::Skip);
+}
+
+TaskScheduler::TimerId TaskScheduler::ScheduleEvery(Clock::duration period, std::shared_ptr<ITask> task,
+    MissedPeriodPolicy policy) {
+    if (!task || period <= Clock::duration::zero()) {
+        if (logger_) {
+            logger_->WriteLine("ScheduleEvery: null task or non-positive period");
+        }
+        return TimerWheel::kInvalidTimer;
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(period).count();
+    if (logger_) {
+        logger_->Log(LogFmt::ScheduleEvery, LogName{ task->GetNameId() }, ms);
+    }
+    std::cout << "ScheduleEvery: " << task->GetName() << " every " << ms << "ms" << std::endl;
+
+    return AddTimer(Clock::now() + period,
+        [this, task]() { ExecuteImmediately(task); },
+        period, policy);
+}
+
+TaskScheduler::TimerId TaskScheduler::AddTimer(Clock::time_point due, TimerWheel::Callback cb,
+    Clock::duration period, MissedPeriodPolicy policy) {
+    if (!running_) {
+        if (logger_) {
+            logger_->WriteLine("AddTimer called but scheduler not running");
+        }
+        return TimerWheel::kInvalidTimer;
+    }
+
+    TimerId id;
+    bool wake = false;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
-        taskQueue_.push(std::move(task));
+        std::lock_guard<std::mutex> lk(timerMtx_);
+        id = timers_.Schedule(due, std::move(cb), period, policy);
+        // ֻ¶ʱڶʱ̵߳ǰĵȴʱʱŻ
+        if (due < timerWakeAt_) {
+            timerWakeAt_ = due;
+            wake = true;
+        }
+    }
+    if (wake) timerCv_.notify_one();
+    return id;
+}
+
+bool TaskScheduler::CancelTimer(TimerId id) {
+    bool cancelled;
+    {
+        std::lock_guard<std::mutex> lk(timerMtx_);
+        cancelled = timers_.Cancel(id);
     }
+    if (cancelled && logger_) {
+        logger_->Log(LogFmt::TimerCancelled, id);
+    }
+    return cancelled;
+}
+
+void TaskScheduler::TimerThread() {
+    TraceRecorder::SetThreadName("Timer");
+    tlsTimerThread = true;
+    std::vector<TimerWheel::Callback> expired;
+
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lk(timerMtx_);
+            if (!running_) break;
+            timers_.Advance(Clock::now(), expired);
+            if (expired.empty()) {
+                timerWakeAt_ = timers_.NextWakeup();
+                if (timerWakeAt_ == Clock::time_point::max()) {
+                    timerCv_.wait(lk);
+                }
+                else {
+                    timerCv_.wait_until(lk, timerWakeAt_);
+                }
+                continue;
+            }
+        }
 
-    cv_.notify_one();  // ֪ͨ߳
+        // ִлصصӶʱ
+        for (auto& cb : expired) {
+            if (cb) cb();
+        }
+        expired.clear();
+    }
 }
 
 void TaskScheduler::CancelCurrent() {
-    std::lock_guard<std::mutex> lk(curMtx_);
-    if (currentToken_) {
-        currentToken_->Cancel();
+    size_t cancelled = 0;
+    {
+        std::lock_guard<std::mutex> lk(curMtx_);
+        for (auto& w : workers_) {
+            if (w->currentToken && !w->currentToken->IsCancelled()) {
+                w->currentToken->Cancel();
+                ++cancelled;
+            }
+        }
+    }
+    // еЭִͬ
+    std::vector<TaskStatePtr> suspended;
+    {
+        std::lock_guard<std::mutex> lk(coMtx_);
+        for (auto& kv : coroutines_) {
+            if (auto s = kv.second.lock()) suspended.push_back(std::move(s));
+        }
+    }
+    for (auto& s : suspended) {
+        if (!s->token->IsCancelled()) {
+            s->token->Cancel();
+            ++cancelled;
+        }
+    }
+    if (cancelled > 0) {
         // 
         if (logger_) {
-            logger_->WriteLine("Cancelling current task");
+            logger_->WriteLine("Cancelling " + std::to_string(cancelled) + " running task(s)");
         }
-        std::cout << "Cancelling current task" << std::endl;
+        std::cout << "Cancelling " << cancelled << " running task(s)" << std::endl;
     }
 }
 
-void TaskScheduler::AddObserver(std::weak_ptr<ITaskObserver> obs) {
-    std::lock_guard<std::mutex> lk(obsMtx_);
-    observers_.push_back(std::move(obs));
-    // 
+size_t TaskScheduler::CancelGroup(const std::string& group) {
+    std::vector<std::weak_ptr<TaskState>> list;
+    {
+        std::lock_guard<std::mutex> lk(groupMtx_);
+        auto it = groups_.find(group);
+        if (it == groups_.end()) return 0;
+        list.swap(it->second);
+        groups_.erase(it);
+    }
+
+    size_t cancelled = 0;
+    for (auto& w : list) {
+        if (auto s = w.lock()) {
+            s->token->Cancel();
+            ++cancelled;
+        }
+    }
+
+    if (logger_) {
+        logger_->Log(LogFmt::CancelGroup, group, cancelled);
+    }
+    std::cout << "CancelGroup: " << group << " (" << cancelled << " tasks)" << std::endl;
+    return cancelled;
+}
+
+void TaskScheduler::CancelAll() {
+    // Ŷеڿʼǰеֱȡ
+    cancelEpoch_.fetch_add(1, std::memory_order_acq_rel);
     if (logger_) {
-        logger_->WriteLine("Observer added");
+        logger_->WriteLine("CancelAll requested");
     }
-    std::cout << "Observer added" << std::endl;
+    std::cout << "CancelAll requested" << std::endl;
+    CancelCurrent();
 }
 
-void TaskScheduler::Notify(const TaskEvent& e) {
+TaskScheduler::SubscriptionId TaskScheduler::Subscribe(std::weak_ptr<ITaskObserver> obs, ObserverFilter filter) {
+    SubscriptionId id = observers_.Add(std::move(obs), std::move(filter));
     // 
-    std::cout << "Notify: " << e.taskName << " - ";
-    switch (e.type) {
-    case TaskEventType::Started: std::cout << "Started"; break;
-    case TaskEventType::Succeeded: std::cout << "Succeeded"; break;
-    case TaskEventType::Failed: std::cout << "Failed"; break;
-    case TaskEventType::Cancelled: std::cout << "Cancelled"; break;
+    if (logger_) {
+        logger_->WriteLine("Observer added (subscription " + std::to_string(id) + ")");
     }
-    if (!e.message.empty()) {
-        std::cout << " - " << e.message;
+    std::cout << "Observer added (subscription " << id << ")" << std::endl;
+    return id;
+}
+
+bool TaskScheduler::Unsubscribe(SubscriptionId id) {
+    bool removed = observers_.Remove(id);
+    if (removed) {
+        if (logger_) {
+            logger_->WriteLine("Observer removed (subscription " + std::to_string(id) + ")");
+        }
+        std::cout << "Observer removed (subscription " << id << ")" << std::endl;
     }
-    std::cout << std::endl;
+    return removed;
+}
+
+void TaskScheduler::AddObserver(std::weak_ptr<ITaskObserver> obs) {
+    Subscribe(std::move(obs));
+}
 
-    // д־
+void TaskScheduler::NotifyQueueFull(const QueueFullEvent& e) {
+    const char* action = "Blocked";
+    switch (e.action) {
+    case QueueFullAction::Blocked:  action = "Blocked"; break;
+    case QueueFullAction::Rejected: action = "Rejected"; break;
+    case QueueFullAction::Dropped:  action = "Dropped"; break;
+    }
+
+    // 
     if (logger_) {
-        std::ostringstream oss;
-        oss << "Notify: Task=" << e.taskName << " Event=";
-        switch (e.type) {
-        case TaskEventType::Started:   oss << "Started"; break;
-        case TaskEventType::Succeeded: oss << "Succeeded"; break;
-        case TaskEventType::Failed:    oss << "Failed"; break;
-        case TaskEventType::Cancelled: oss << "Cancelled"; break;
-        }
-        if (!e.message.empty()) oss << " Msg=" << e.message;
-        logger_->WriteLine(oss.str());
+        logger_->WriteLine(std::string("Queue full (capacity ") + std::to_string(e.capacity) + "): "
+            + action + " " + TaskNames::Get(e.name));
     }
+    if (ConsoleOutput()) std::cout << "Queue full (capacity " << e.capacity << "): " << action << " " << TaskNames::Get(e.name) << std::endl;
 
-    // ֪ͨ۲
-    std::vector<std::shared_ptr<ITaskObserver>> activeObservers;
-    {
-        std::lock_guard<std::mutex> lk(obsMtx_);
-        for (auto it = observers_.begin(); it != observers_.end();) {
-            if (auto sp = it->lock()) {
-                activeObservers.push_back(sp);
-                ++it;
-            }
-            else {
-                it = observers_.erase(it);
-            }
+    // ύ߳ϵãֻգͷַ߳
+    auto snapshot = observers_.Load();
+    for (const auto& sub : *snapshot) {
+        if (!sub.filter.AcceptsQueueFull(e.name, e.group)) continue;
+        if (auto obs = sub.observer.lock()) {
+            obs->OnQueueFull(e);
         }
     }
+}
 
-    // ֪ͨлԾĹ۲
-    for (auto& obs : activeObservers) {
-        obs->OnTaskEvent(e);
+void TaskScheduler::Notify(TaskEventType type, const TaskState& state, std::string_view message) {
+    // ֻ߳¼Žʽ͹۲߻صڷַ߳
+    TaskEvent e;
+    e.type = type;
+    e.name = state.nameId;
+    e.group = state.groupId;
+    e.taskId = state.id;
+    const auto now = Clock::now();
+    e.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    e.message = MessagePool::Store(message);
+    if (type == TaskEventType::Cancelled && TraceRecorder::Enabled()) {
+        TraceRecorder::Instant(TraceKind::Cancel, state.nameId, state.id, now);
     }
+    events_.Publish(e);
 }
 
-void TaskScheduler::WorkerThread() {
-    if (logger_) {
-        logger_->WriteLine("WorkerThread started");
+void TaskScheduler::DispatchEvents(std::vector<TaskEvent>& batch) {
+    const bool tracing = TraceRecorder::Enabled();
+    const auto traceBegin = tracing ? Clock::now() : Clock::time_point();
+    if (tracing) {
+        thread_local bool named = false;
+        if (!named) {
+            named = true;
+            TraceRecorder::SetThreadName("Event dispatch");
+        }
     }
-    std::cout << "WorkerThread started" << std::endl;
 
-    while (true) {
-        std::shared_ptr<ITask> task;
+    // ÿֻһοղһι۲ߣڱǰЧֱ
+    auto snapshot = observers_.Load();
+    bool expired = false;
+    for (const auto& sub : *snapshot) {
+        if (auto obs = sub.observer.lock()) {
+            dispatchTargets_.emplace_back(std::move(obs), &sub.filter);
+        }
+        else {
+            expired = true;
+        }
+    }
 
-        // ȡ
-        {
-            std::unique_lock<std::mutex> lk(mtx_);
+    std::string& line = dispatchLine_;
+    for (const auto& e : batch) {
+        // ֻʽһΣ̨־
+        line.assign("Notify: Task=");
+        line += e.Name();
+        line += " Event=";
+        switch (e.type) {
+        case TaskEventType::Started:   line += "Started"; break;
+        case TaskEventType::Succeeded: line += "Succeeded"; break;
+        case TaskEventType::Failed:    line += "Failed"; break;
+        case TaskEventType::Cancelled: line += "Cancelled"; break;
+        }
+        if (!e.message.Empty()) {
+            line += " Msg=";
+            if (!MessagePool::AppendTo(e.message, line)) line += MessagePool::kLostText;
+        }
 
-            // ȴֹͣź
-            cv_.wait(lk, [&]() {
-                return !running_ || !taskQueue_.empty();
-                });
+        // 
+        if (ConsoleOutput()) std::cout << line << '\n';
+        if (logger_) {
+            logger_->WriteLine(line);
+        }
 
-            // Ƿֹͣ
-            if (!running_) {
-                if (logger_) {
-                    logger_->WriteLine("WorkerThread stopping (running_=false)");
-                }
-                std::cout << "WorkerThread stopping" << std::endl;
-                break;
+        for (auto& target : dispatchTargets_) {
+            if (target.second->Accepts(e.type, e.name, e.group)) {
+                target.first->OnTaskEvent(e);
             }
+        }
+
+        if (TaskLatency* stats = latency_.Get(e.name)) {
+            stats->notify.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now().time_since_epoch()).count() - e.timestampNs);
+        }
+    }
+    if (ConsoleOutput()) std::cout.flush();
 
-            // ȡ
-            if (!taskQueue_.empty()) {
-                task = taskQueue_.front();
-                taskQueue_.pop();
+    dispatchTargets_.clear();
+    if (expired) observers_.RemoveExpired();
 
-                if (logger_) {
-                    logger_->WriteLine("WorkerThread got task: " + task->GetName());
-                }
-                std::cout << "WorkerThread got task: " << task->GetName() << std::endl;
+    if (tracing) {
+        TraceRecorder::Span(TraceKind::Dispatch, kInvalidName, 0, traceBegin, Clock::now(), batch.size());
+    }
+}
+
+TaskStatePtr TaskScheduler::PopLocal(Worker& self) {
+    std::lock_guard<std::mutex> lk(self.mtx);
+    if (self.tasks.empty()) return nullptr;
+    auto task = std::move(self.tasks.front());
+    self.tasks.pop_front();
+    return task;
+}
+
+TaskStatePtr TaskScheduler::Steal(size_t thief) {
+    const size_t n = workers_.size();
+    for (size_t i = 1; i < n; ++i) {
+        Worker& victim = *workers_[(thief + i) % n];
+        std::lock_guard<std::mutex> lk(victim.mtx);
+        if (victim.tasks.empty()) continue;
+        auto task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return task;
+    }
+    return nullptr;
+}
+
+TaskStatePtr TaskScheduler::FindTask(Worker& self, size_t index, bool& stolen) {
+    // ȡԼĶУٰȼȡύУ߳ȡ
+    stolen = false;
+    TaskStatePtr task = PopLocal(self);
+    if (!task) task = PopLanes();
+    if (!task) {
+        task = Steal(index);
+        stolen = (task != nullptr);
+    }
+    return task;
+}
+
+void TaskScheduler::WorkerThread(size_t index) {
+    tlsScheduler = this;
+    tlsWorkerIndex = index;
+    Worker& self = *workers_[index];
+    TraceRecorder::SetThreadName("Worker #" + std::to_string(index));
+
+    if (logger_) {
+        logger_->Log(LogFmt::WorkerStarted, index);
+    }
+    std::cout << "WorkerThread #" << index << " started" << std::endl;
+
+    while (running_) {
+        bool stolen = false;
+        TaskStatePtr task = FindTask(self, index, stolen);
+
+        if (!task) {
+            // ǼߺټһΣǰύ
+            uint64_t epoch = parker_.PrepareWait();
+            task = FindTask(self, index, stolen);
+            if (task || !running_) {
+                parker_.CancelWait();
             }
             else {
+                parker_.Wait(epoch);
                 continue;
             }
         }
 
-        // ȡ
-        auto token = std::make_shared<CancellationToken>();
-        {
-            std::lock_guard<std::mutex> lk(curMtx_);
-            currentToken_ = token;
+        if (task) {
+            if (logger_) {
+                logger_->Log(stolen ? LogFmt::WorkerStoleTask : LogFmt::WorkerGotTask, index, LogName{ task->nameId });
+            }
+            if (ConsoleOutput()) std::cout << "WorkerThread #" << index << (stolen ? " stole task: " : " got task: ")
+                    << TaskNames::Get(task->nameId) << std::endl;
+
+            // дƺͿʼʱ䣬дţSnapshot Աжæ
+            const int64_t begin = SteadyNs(Clock::now());
+            self.currentName.store(task->nameId, std::memory_order_relaxed);
+            self.busySinceNs.store(begin, std::memory_order_relaxed);
+            self.currentTaskId.store(task->id, std::memory_order_release);
+
+            RunTask(self, task);
+
+            self.currentTaskId.store(0, std::memory_order_release);
+            self.busyNs.fetch_add(SteadyNs(Clock::now()) - begin, std::memory_order_relaxed);
+            self.tasksRun.fetch_add(1, std::memory_order_relaxed);
         }
+    }
 
-        // ֪ͨʼ
-        Notify({ TaskEventType::Started, task->GetName(), "" });
+    if (logger_) {
+        logger_->Log(LogFmt::WorkerEnded, index);
+    }
+    std::cout << "WorkerThread #" << index << " ended" << std::endl;
+    tlsScheduler = nullptr;
+}
 
-        std::string result;
-        bool taskCancelled = false;
+void TaskScheduler::RunTask(Worker& self, const TaskStatePtr& state) {
+    // ӵЭӹ
+    if (state->coroutine) {
+        ResumeCoroutine(self, state);
+        return;
+    }
 
-        try {
-            if (logger_) {
-                logger_->WriteLine("Executing task: " + task->GetName());
+    const auto& task = state->task;
+    const std::string& name = TaskNames::Get(state->nameId);
+
+    const auto& token = state->token;
+
+    if (state->cancelEpoch < cancelEpoch_.load(std::memory_order_acquire)) {
+        token->Cancel();
+    }
+
+    // Ŷڼѱȡֱӽ
+    if (token->IsCancelled()) {
+        if (logger_) {
+            logger_->Log(LogFmt::TaskCancelledBeforeStart, LogName{ state->nameId });
+        }
+        if (ConsoleOutput()) std::cout << "Task cancelled before start: " << name << std::endl;
+        Notify(TaskEventType::Cancelled, *state, "Cancelled before start");
+        FinishState(state, TaskResult::Cancelled("Cancelled before start"));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(curMtx_);
+        self.currentToken = token;
+    }
+
+    state->startedAt = Clock::now();
+    if (state->latency) {
+        state->latency->queueWait.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            state->startedAt - state->submittedAt).count());
+    }
+
+    // ֪ͨʼ
+    Notify(TaskEventType::Started, *state);
+
+    TaskResult result;
+
+    try {
+        if (logger_) {
+            logger_->Log(LogFmt::TaskExecuting, LogName{ state->nameId });
+        }
+        if (ConsoleOutput()) std::cout << "Executing task: " << name << std::endl;
+
+        // Эִеһọ́߳ʱ CompleteCoroutine β
+        if (auto* co = dynamic_cast<CoroutineTask*>(task.get())) {
+            auto h = co->RunAsync(token).Release();
+            h.promise().scheduler = this;
+            h.promise().state = state;
+            h.promise().token = token;
+            state->coroutine = h;
+            {
+                std::lock_guard<std::mutex> lk(coMtx_);
+                coroutines_[state->id] = state;
             }
-            std::cout << "Executing task: " << task->GetName() << std::endl;
+            ResumeCoroutine(self, state);
+            return;
+        }
 
-            // ִ
-            result = task->Execute(token);
+        // ִ״̬ʽ
+        result = task->Run(token);
 
-            // Ƿȡ
-            if (token && token->IsCancelled()) {
-                taskCancelled = true;
-                if (logger_) {
-                    logger_->WriteLine("Task cancelled during execution: " + task->GetName());
-                }
-                std::cout << "Task cancelled: " << task->GetName() << std::endl;
+        // ƱȡʱȡΪ׼
+        if (token && token->IsCancelled() && result.status != TaskStatus::Cancelled) {
+            result = TaskResult::Cancelled(state->deadlineExpired ? "Deadline exceeded" : "Cancelled by user or TaskD");
+        }
+
+        switch (result.status) {
+        case TaskStatus::Cancelled:
+            if (logger_) {
+                logger_->Log(LogFmt::TaskCancelledDuringExecution, LogName{ state->nameId });
             }
-            else {
-                if (logger_) {
-                    logger_->WriteLine("Task succeeded: " + task->GetName() + " Result: " + result);
-                }
-                std::cout << "Task succeeded: " << task->GetName() << " Result: " << result << std::endl;
+            if (ConsoleOutput()) std::cout << "Task cancelled: " << name << std::endl;
+            break;
+        case TaskStatus::Failed:
+        case TaskStatus::Rejected:
+            if (logger_) {
+                logger_->Log(LogFmt::TaskFailed, LogName{ state->nameId }, result.payload);
             }
-        }
-        catch (const std::exception& ex) {
-            if (token && token->IsCancelled()) {
-                taskCancelled = true;
-                if (logger_) {
-                    logger_->WriteLine("Task cancelled (exception): " + task->GetName() + " Error: " + ex.what());
-                }
-                std::cout << "Task cancelled with exception: " << task->GetName() << " - " << ex.what() << std::endl;
+            if (ConsoleOutput()) std::cout << "Task failed: " << name << " - " << result.payload << std::endl;
+            break;
+        case TaskStatus::Succeeded:
+            if (logger_) {
+                logger_->Log(LogFmt::TaskSucceeded, LogName{ state->nameId }, result.payload);
             }
-            else {
-                result = ex.what();
-                if (logger_) {
-                    logger_->WriteLine("Task failed: " + task->GetName() + " Error: " + ex.what());
-                }
-                std::cout << "Task failed: " << task->GetName() << " - " << ex.what() << std::endl;
+            if (ConsoleOutput()) std::cout << "Task succeeded: " << name << " Result: " << result.payload << std::endl;
+            break;
+        }
+    }
+    catch (const std::exception& ex) {
+        if (token && token->IsCancelled()) {
+            result = TaskResult::Cancelled(state->deadlineExpired ? "Deadline exceeded" : "Cancelled by user or TaskD");
+            if (logger_) {
+                logger_->Log(LogFmt::TaskCancelledException, LogName{ state->nameId }, ex.what());
             }
+            if (ConsoleOutput()) std::cout << "Task cancelled with exception: " << name << " - " << ex.what() << std::endl;
         }
-        catch (...) {
-            result = "Unknown exception";
+        else {
+            result = TaskResult::Failure(ex.what());
             if (logger_) {
-                logger_->WriteLine("Task unknown error: " + task->GetName());
+                logger_->Log(LogFmt::TaskFailed, LogName{ state->nameId }, ex.what());
             }
-            std::cout << "Task unknown error: " << task->GetName() << std::endl;
+            if (ConsoleOutput()) std::cout << "Task failed: " << name << " - " << ex.what() << std::endl;
         }
-
-        // ֪ͨ
-        if (taskCancelled) {
-            Notify({ TaskEventType::Cancelled, task->GetName(), "Cancelled by user or TaskD" });
+    }
+    catch (...) {
+        result = TaskResult::Failure("Unknown exception");
+        if (logger_) {
+            logger_->Log(LogFmt::TaskUnknownError, LogName{ state->nameId });
         }
-        else if (!result.empty() && result.find("cancelled") != std::string::npos) {
-            Notify({ TaskEventType::Cancelled, task->GetName(), result });
+        if (ConsoleOutput()) std::cout << "Task unknown error: " << name << std::endl;
+    }
+
+    RecordRunTime(*state);
+    if (TraceRecorder::Enabled()) {
+        TraceRecorder::Span(TraceKind::Run, state->nameId, state->id, state->startedAt, Clock::now());
+    }
+
+    // ֪ͨ
+    NotifyResult(*state, result);
+
+    // ǰ
+    {
+        std::lock_guard<std::mutex> lk(curMtx_);
+        self.currentToken.reset();
+    }
+
+    if (logger_) {
+        logger_->Log(LogFmt::TaskCompleted, LogName{ state->nameId });
+    }
+    if (ConsoleOutput()) std::cout << "Task completed: " << name << std::endl;
+
+    // ѵȴĵ÷
+    FinishState(state, std::move(result));
+}
+
+void TaskScheduler::RecordRunTime(const TaskState& state) {
+    if (state.latency) {
+        state.latency->run.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - state.startedAt).count());
+    }
+}
+
+void TaskScheduler::NotifyResult(const TaskState& state, const TaskResult& result) {
+    switch (result.status) {
+    case TaskStatus::Cancelled:
+        Notify(TaskEventType::Cancelled, state, result.payload);
+        break;
+    case TaskStatus::Failed:
+    case TaskStatus::Rejected:
+        Notify(TaskEventType::Failed, state, result.payload.empty() ? "Unknown error" : std::string_view(result.payload));
+        break;
+    case TaskStatus::Succeeded:
+        Notify(TaskEventType::Succeeded, state, result.payload);
+        break;
+    }
+}
+
+void TaskScheduler::ResumeCoroutine(Worker& self, const TaskStatePtr& state) {
+    if (state->cancelEpoch < cancelEpoch_.load(std::memory_order_acquire)) {
+        state->token->Cancel();
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(curMtx_);
+        self.currentToken = state->token;
+    }
+
+    // Эÿλָʱϸһ
+    const bool tracing = TraceRecorder::Enabled();
+    const auto traceBegin = tracing ? Clock::now() : Clock::time_point();
+
+    // ִеһغЭָ̻̿߳ٷЭ֡
+    state->coroutine.resume();
+
+    if (tracing) {
+        TraceRecorder::Span(TraceKind::Run, state->nameId, state->id, traceBegin, Clock::now());
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(curMtx_);
+        self.currentToken.reset();
+    }
+}
+
+void TaskScheduler::Resume(TaskStatePtr state) {
+    if (!state) return;
+
+    // ֹͣʱЭ̲ٻֱָӽ񣬵ȴĵ÷һֱ
+    if (!PushToWorker(state)) {
+        FinishState(state, TaskResult::Cancelled("Cancelled: scheduler stopped"));
+        return;
+    }
+    parker_.NotifyOne();
+}
+
+bool TaskScheduler::PushToWorker(const TaskStatePtr& state) {
+    if (!running_) return false;
+
+    // ʱ̻߳ I/O ߳ύẉ̻̂߳߳ȡ
+    const size_t index = tlsScheduler == this
+        ? tlsWorkerIndex
+        : resumeCursor_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    Worker& w = *workers_[index];
+    std::lock_guard<std::mutex> lk(w.mtx);
+    // ڶټһΣStop ն֮󵽴񲻻ڶ
+    if (!running_) return false;
+    w.tasks.push_back(state);
+    return true;
+}
+
+void TaskScheduler::CompleteCoroutine(const TaskStatePtr& state, TaskResult result, std::exception_ptr error) {
+    const std::string& name = TaskNames::Get(state->nameId);
+    const auto& token = state->token;
+
+    if (error) {
+        try {
+            std::rethrow_exception(error);
         }
-        else if (result.empty() || result.find("error") != std::string::npos || result.find("Error") != std::string::npos) {
-            Notify({ TaskEventType::Failed, task->GetName(), result.empty() ? "Unknown error" : result });
+        catch (const std::exception& ex) {
+            if (token->IsCancelled()) {
+                result = TaskResult::Cancelled(state->deadlineExpired ? "Deadline exceeded" : "Cancelled by user or TaskD");
+            }
+            else {
+                result = TaskResult::Failure(ex.what());
+            }
         }
-        else {
-            Notify({ TaskEventType::Succeeded, task->GetName(), result });
+        catch (...) {
+            result = TaskResult::Failure("Unknown exception");
         }
+    }
+    else if (token->IsCancelled() && result.status != TaskStatus::Cancelled) {
+        result = TaskResult::Cancelled(state->deadlineExpired ? "Deadline exceeded" : "Cancelled by user or TaskD");
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(coMtx_);
+        coroutines_.erase(state->id);
+    }
+
+    // 
+    if (logger_) {
+        logger_->Log(LogFmt::CoroutineFinished, LogName{ state->nameId }, result.payload);
+    }
+    if (ConsoleOutput()) std::cout << "Coroutine task finished: " << name << " Result: " << result.payload << std::endl;
+
+    RecordRunTime(*state);
+    NotifyResult(*state, result);
+
+    if (logger_) {
+        logger_->Log(LogFmt::TaskCompleted, LogName{ state->nameId });
+    }
+    if (ConsoleOutput()) std::cout << "Task completed: " << name << std::endl;
+
+    FinishState(state, std::move(result));
+}
+
+SchedulerSnapshot TaskScheduler::Snapshot() const {
+    SchedulerSnapshot snap;
+    // mtx_ ֻ Start/Stop ⣨ǻ滻̺߳ͶУӰִ
+    std::lock_guard<std::mutex> lk(mtx_);
+
+    const auto now = Clock::now();
+    const int64_t nowNs = SteadyNs(now);
+    snap.running = running_;
+    if (snap.running) snap.uptime = now - startedAt_;
+    const int64_t uptimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(snap.uptime).count();
 
-        // ǰ
+    for (size_t i = 0; i < kTaskPriorityCount; ++i) {
+        snap.laneDepth[i] = lanes_[i] ? lanes_[i]->SizeApprox() : 0;
+    }
+    snap.queued = pending_.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        Worker& w = *workers_[i];
+        WorkerSnapshot ws;
+        ws.index = i;
+
+        // ıǰһ²ŲƺͿʼʱ䣬Ϊպû
+        uint64_t id = w.currentTaskId.load(std::memory_order_acquire);
+        NameId name = w.currentName.load(std::memory_order_relaxed);
+        int64_t since = w.busySinceNs.load(std::memory_order_relaxed);
+        if (id != 0 && w.currentTaskId.load(std::memory_order_acquire) == id) {
+            ws.busy = true;
+            ws.taskId = id;
+            ws.taskName = TaskNames::Get(name);
+            ws.busyFor = std::chrono::nanoseconds(std::max<int64_t>(0, nowNs - since));
+        }
         {
-            std::lock_guard<std::mutex> lk(curMtx_);
-            currentToken_.reset();
+            std::lock_guard<std::mutex> wlk(w.mtx);
+            ws.localQueue = w.tasks.size();
         }
-
-        if (logger_) {
-            logger_->WriteLine("Task completed: " + task->GetName());
+        ws.tasksRun = w.tasksRun.load(std::memory_order_relaxed);
+        const int64_t busy = w.busyNs.load(std::memory_order_relaxed)
+            + (ws.busy ? std::chrono::duration_cast<std::chrono::nanoseconds>(ws.busyFor).count() : 0);
+        ws.busyTotal = std::chrono::nanoseconds(busy);
+        if (uptimeNs > 0) {
+            ws.utilization = std::min(1.0, static_cast<double>(busy) / static_cast<double>(uptimeNs));
         }
-        std::cout << "Task completed: " << task->GetName() << std::endl;
+        if (ws.busy) {
+            InFlightTask t;
+            t.id = ws.taskId;
+            t.name = ws.taskName;
+            t.elapsed = ws.busyFor;
+            t.worker = static_cast<int>(i);
+            snap.inFlight.push_back(std::move(t));
+        }
+        snap.workers.push_back(std::move(ws));
     }
 
-    if (logger_) {
-        logger_->WriteLine("WorkerThread ended");
+    // еЭκι߳ϣִ
+    std::vector<TaskStatePtr> coroutines;
+    {
+        std::lock_guard<std::mutex> clk(coMtx_);
+        coroutines.reserve(coroutines_.size());
+        for (const auto& entry : coroutines_) {
+            if (auto state = entry.second.lock()) coroutines.push_back(std::move(state));
+        }
+    }
+    for (const auto& state : coroutines) {
+        bool onWorker = std::any_of(snap.inFlight.begin(), snap.inFlight.end(),
+            [&](const InFlightTask& t) { return t.id == state->id; });
+        if (onWorker) continue;
+        InFlightTask t;
+        t.id = state->id;
+        t.name = TaskNames::Get(state->nameId);
+        t.elapsed = now - state->startedAt;
+        t.suspended = true;
+        snap.inFlight.push_back(std::move(t));
     }
-    std::cout << "WorkerThread ended" << std::endl;
+
+    snap.submitted = submitted_.load(std::memory_order_relaxed);
+    snap.succeeded = succeeded_.load(std::memory_order_relaxed);
+    snap.failed = failed_.load(std::memory_order_relaxed);
+    snap.cancelled = cancelled_.load(std::memory_order_relaxed);
+    snap.rejected = rejected_.load(std::memory_order_relaxed);
+    snap.observerCount = observers_.Size();
+    snap.eventsDropped = events_.Dropped();
+    snap.messagesLost = MessagePool::Lost();
+    return snap;
 }
\ No newline at end of file
@@ -1,17 +1,37 @@
 #pragma once
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <atomic>
+#include <iterator>
+#include <unordered_map>
 
 #include "ScheduledTask.h"
+#include "TimerWheel.h"
+#include "BoundedQueue.h"
+#include "Parker.h"
 #include "LogWriter.h"
 #include "ITaskObserver.h"
+#include "ObserverRegistry.h"
+#include "EventBus.h"
+#include "QueuePolicy.h"
 #include "CancellationToken.h"
+#include "TaskHandle.h"
+#include "CoroutineTask.h"
+#include "SchedulerSnapshot.h"
+
+// ύѡ
+struct SubmitOptions {
+    std::string group;                                  //  CancelGroup ȡ
+    std::chrono::steady_clock::duration timeout{ 0 };  //  0 ʱʱԶȡ
+    TaskPriority priority = TaskPriority::Normal;
+};
 
 class TaskScheduler {
 public:
@@ -19,33 +39,178 @@ public:
 
     static TaskScheduler& Instance();
 
-    void Start(std::shared_ptr<LogWriter> logger);
+    // workerCount Ϊ 0 ʱʹ std::thread::hardware_concurrency()
+    void Start(std::shared_ptr<LogWriter> logger, size_t workerCount = 0, const QueueOptions& queue = {},
+        const EventBusOptions& events = {});
     void Stop();
 
-    // ִŻİ汾
-    void ExecuteImmediately(std::shared_ptr<ITask> task);
+    // ִŻİ汾صľɵȴ
+    TaskHandle ExecuteImmediately(std::shared_ptr<ITask> task, const SubmitOptions& options = {});
+
+    // ύһ־СһԻѹ߳
+    // صľ tasks һһӦδʱӦЧ
+    std::vector<TaskHandle> ExecuteBatch(std::vector<std::shared_ptr<ITask>> tasks,
+        const SubmitOptions& options = {});
+
+    template <class It>
+    std::vector<TaskHandle> ExecuteBatch(It first, It last, const SubmitOptions& options = {}) {
+        return ExecuteBatch(std::vector<std::shared_ptr<ITask>>(first, last), options);
+    }
 
+    template <class Range>
+    std::vector<TaskHandle> ExecuteBatch(const Range& tasks, const SubmitOptions& options = {}) {
+        return ExecuteBatch(std::begin(tasks), std::end(tasks), options);
+    }
+
+    // ӳ񣬷ص id  CancelTimer
+    using TimerId = TimerWheel::TimerId;
+    TimerId ScheduleAfter(Clock::duration delay, std::shared_ptr<ITask> task);
+    TimerId ScheduleEvery(Clock::duration period, std::shared_ptr<ITask> task,
+        MissedPeriodPolicy policy = MissedPeriodPolicy::Skip);
+    bool CancelTimer(TimerId id);
+
+    // ¼filter ¼ͨ͡ɸѡڷַ߳ж
+    using SubscriptionId = ObserverRegistry::SubscriptionId;
+    SubscriptionId Subscribe(std::weak_ptr<ITaskObserver> obs, ObserverFilter filter = {});
+    bool Unsubscribe(SubscriptionId id);
     void AddObserver(std::weak_ptr<ITaskObserver> obs);
 
-    // TaskD ãȡǰִе
+    // TaskD ãȡйִ߳е
     void CancelCurrent();
 
+    //  TaskHandle::Cancel()°ȫȡŶе
+    size_t CancelGroup(const std::string& group);
+    void CancelAll();
+
+    // ÿŶӵȴִС֪ͨʱֲp50/p99/p999
+    std::vector<TaskLatencyReport> LatencyReport() const { return latency_.Report(); }
+    // ͺϲķֲ
+    TaskLatencyReport LatencyTotal() const { return latency_.Total(); }
+    void ResetLatency() { latency_.Reset(); }
+
+    // ״̬գȡִе񡢸߳æСۼƽͣ߳
+    SchedulerSnapshot Snapshot() const;
+
+    size_t WorkerCount() const { return workerCount_.load(std::memory_order_relaxed); }
+
+    // Ŀ̨ύִС¼ַĬϹرգ־ʼͬļ¼
+    void SetConsoleOutput(bool enabled) { consoleOutput_.store(enabled, std::memory_order_relaxed); }
+
 private:
+    // ЭĵȴҪʱӺϱ
+    friend struct ResumeGate;
+    friend class Delay;
+    friend class AwaitIo;
+    friend struct CoroutineTask::FinalAwaiter;
+
+    // ÿ߳ӵԼ˫˶УԼӶȡ̴߳Ӷβȡ
+    // ֻй߳ڲύŽ˫˶
+    struct Worker {
+        std::deque<TaskStatePtr> tasks;
+        std::mutex mtx;
+        std::thread thread;
+        CancellationTokenPtr currentToken;  //  curMtx_ 
+
+        // ɱ߳дSnapshot ȡ
+        std::atomic<uint64_t> currentTaskId{ 0 };  // 0 ʾ
+        std::atomic<NameId> currentName{ kInvalidName };
+        std::atomic<int64_t> busySinceNs{ 0 };
+        std::atomic<int64_t> busyNs{ 0 };  // ѽۼִʱ
+        std::atomic<uint64_t> tasksRun{ 0 };
+    };
+
     TaskScheduler() = default;
-    void WorkerThread();
-    void Notify(const TaskEvent& e);
+    bool ConsoleOutput() const { return consoleOutput_.load(std::memory_order_relaxed); }
+    void WorkerThread(size_t index);
+    TaskStatePtr MakeState(std::shared_ptr<ITask> task, const SubmitOptions& options);
+    // ͬŶӻʱ attached½״̬submission ǽ÷״̬
+    TaskStatePtr MakeOrAttach(std::shared_ptr<ITask> task, const SubmitOptions& options, bool& attached,
+        TaskStatePtr& submission);
+    TaskStatePtr MakeSubmission(const TaskStatePtr& shared);
+    // Ѿ״̬ falseͺظ
+    bool FinishState(const TaskStatePtr& state, TaskResult result);
+    //  false ʾԾܾ˸ Rejected 
+    bool Enqueue(TaskStatePtr state);
+    bool PushLane(TaskStatePtr& state);
+    TaskStatePtr PopLanes();
+    TaskStatePtr PopVictim(TaskPriority incoming);
+    void Reject(const TaskStatePtr& state, QueueFullAction action, const char* message);
+    void NotifyQueueFull(const QueueFullEvent& e);
+    void RunTask(Worker& self, const TaskStatePtr& state);
+    void ResumeCoroutine(Worker& self, const TaskStatePtr& state);
+    void CompleteCoroutine(const TaskStatePtr& state, TaskResult result, std::exception_ptr error);
+    // Э̾Żĳ̵߳Ķ
+    void Resume(TaskStatePtr state);
+    // Žĳ߳ԼĶУύƣֹͣʱ false
+    bool PushToWorker(const TaskStatePtr& state);
+    void RecordRunTime(const TaskState& state);
+    void NotifyResult(const TaskState& state, const TaskResult& result);
+    TaskStatePtr PopLocal(Worker& self);
+    TaskStatePtr Steal(size_t thief);
+    TaskStatePtr FindTask(Worker& self, size_t index, bool& stolen);
+    void Notify(TaskEventType type, const TaskState& state, std::string_view message = {});
+    void DispatchEvents(std::vector<TaskEvent>& batch);
+    void TimerThread();
+    TimerId AddTimer(Clock::time_point due, TimerWheel::Callback cb,
+        Clock::duration period, MissedPeriodPolicy policy);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> workerCount_{ 0 };
+
+    // ⲿ̵߳ύȼУֻ߳ʱҪ
+    // pending_ ͳƸȼеʱִ
+    QueueOptions queueOptions_;
+    std::unique_ptr<BoundedQueue<TaskStatePtr>> lanes_[kTaskPriorityCount];
+    std::atomic<size_t> pending_{ 0 };
+    std::atomic<size_t> blockedProducers_{ 0 };
+    std::mutex spaceMtx_;
+    std::condition_variable spaceCv_;
+    std::atomic<uint64_t> nextTaskId_{ 1 };
+    Parker parker_;
+
+    mutable std::mutex mtx_;
+    std::atomic<bool> running_{ false };
+    Clock::time_point startedAt_;
 
-    std::queue<std::shared_ptr<ITask>> taskQueue_;
-    std::mutex mtx_;
-    std::condition_variable cv_;
-    bool running_{ false };
-    std::thread worker_;
+    // ۼƣ FinishState м
+    std::atomic<uint64_t> submitted_{ 0 };
+    std::atomic<uint64_t> succeeded_{ 0 };
+    std::atomic<uint64_t> failed_{ 0 };
+    std::atomic<uint64_t> cancelled_{ 0 };
+    std::atomic<uint64_t> rejected_{ 0 };
 
     std::shared_ptr<LogWriter> logger_;
+    std::atomic<bool> consoleOutput_{ false };
 
-    std::mutex obsMtx_;
-    std::vector<std::weak_ptr<ITaskObserver>> observers_;
+    // ʱֻ߳ĵʱÿ tick
+    std::mutex timerMtx_;
+    std::condition_variable timerCv_;
+    TimerWheel timers_;
+    Clock::time_point timerWakeAt_{ Clock::time_point::max() };
+    std::thread timerThread_;
+
+    // ¼ַ̣̲߳߳ȹ۲
+    EventBus events_;
+    ObserverRegistry observers_;
+    TaskLatencyTable latency_;
+    // ֻڷַ߳ʹãĹ۲ߺ͸ʽ壬θ
+    std::vector<std::pair<std::shared_ptr<ITaskObserver>, const ObserverFilter*>> dispatchTargets_;
+    std::string dispatchLine_;
 
     std::mutex curMtx_;
-    CancellationTokenPtr currentToken_;
+
+    // ѿʼЭ񣨹ڼ䲻κι߳ϣCancelCurrent ҲҪȡ
+    mutable std::mutex coMtx_;
+    std::unordered_map<uint64_t, std::weak_ptr<TaskState>> coroutines_;
+    std::atomic<size_t> resumeCursor_{ 0 };
+
+    // CancelAll ύڵǰڿʼǰȡ
+    std::atomic<uint64_t> cancelEpoch_{ 0 };
+
+    std::mutex groupMtx_;
+    std::unordered_map<std::string, std::vector<std::weak_ptr<TaskState>>> groups_;
+
+    // ϲ -> Ŷӻе
+    std::mutex coalesceMtx_;
+    std::unordered_map<std::string, TaskStatePtr> coalescing_;
 };
\ No newline at end of file
@@ -1,4 +1,11 @@
 #include "Tasks.h"
+#include "Gemm.h"
+#include "StreamingStats.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <chrono>
 #include <thread>
 #include <random>
@@ -32,16 +39,18 @@ static std::string GetCurrentDate() {
 }
 
 // -------------------- TaskA: ļ --------------------
-std::string FileBackupTask::Execute(const CancellationTokenPtr& token) {
-    std::cout << "FileBackupTask::Execute started" << std::endl;
+CoroutineTask::Body FileBackupTask::RunAsync(CancellationTokenPtr) {
+    std::cout << "FileBackupTask::RunAsync started" << std::endl;
 
-    // ģ⹤
+    // ģ⹤ڼ乤߳ȥִȡʱ
     for (int i = 0; i < 5; i++) {
-        if (token && token->IsCancelled()) {
+        try {
+            co_await Delay(std::chrono::milliseconds(200));
+        }
+        catch (const TaskCancelledError&) {
             std::cout << "FileBackupTask cancelled" << std::endl;
-            return "Backup cancelled at step " + std::to_string(i);
+            co_return TaskResult::Cancelled("Backup cancelled at step " + std::to_string(i));
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
 
     try {
@@ -64,88 +73,260 @@ std::string FileBackupTask::Execute(const CancellationTokenPtr& token) {
         }
 
         std::cout << "FileBackupTask completed: " << backupPath.string() << std::endl;
-        return "Backup created: " + backupPath.string();
+        co_return TaskResult::Success("Backup created: " + backupPath.string());
     }
     catch (const std::exception& e) {
         std::cout << "FileBackupTask error: " << e.what() << std::endl;
-        return "Backup error: " + std::string(e.what());
+        co_return TaskResult::Failure("Backup error: " + std::string(e.what()));
     }
 }
 
 // -------------------- TaskB: ˷ --------------------
-std::string MatrixMultiplyTask::Execute(const CancellationTokenPtr& token) {
-    std::cout << "MatrixMultiplyTask::Execute started" << std::endl;
+namespace {
+
+// ֿߴǸ΢ںˣ12x166x84x4ĹֿڲֱԵխ
+constexpr size_t kTileRows = 240;
+constexpr size_t kTileCols = 256;
+
+// һβг˷Ĺ״̬ÿֻֿᱻһΣ߿ҲǸ
+template <class T>
+struct MatrixTileJob {
+    const T* A = nullptr;
+    const T* B = nullptr;
+    T* C = nullptr;
+    size_t n = 0;
+    size_t rowTiles = 0;
+    size_t colTiles = 0;
+    CancellationTokenPtr token;  // ƣзֿ鹲
+
+    std::unique_ptr<std::atomic<bool>[]> claimed;
+    std::atomic<size_t> finished{ 0 };
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    size_t TileCount() const { return rowTiles * colTiles; }
+
+    // ѱ췵 falseȡķֿ鲻ټ㣬ֻ
+    bool RunTile(size_t tile) {
+        if (claimed[tile].exchange(true, std::memory_order_acq_rel)) return false;
+
+        if (!token->IsCancelled()) {
+            const size_t i0 = tile / colTiles * kTileRows;
+            const size_t j0 = tile % colTiles * kTileCols;
+            const size_t rows = std::min(kTileRows, n - i0);
+            const size_t cols = std::min(kTileCols, n - j0);
+            MatrixKernel::Blocked<T>(A + i0 * n, n, B + j0, n, C + i0 * n + j0, n, rows, cols, n, token.get());
+        }
+
+        if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == TileCount()) {
+            std::lock_guard<std::mutex> lk(mtx);
+            cv.notify_all();
+        }
+        return true;
+    }
+};
+
+// ֿ񣺸ԼҲֿ飬ִֵʱֿѾ
+template <class T>
+class MatrixTileTask : public TypedTask {
+public:
+    MatrixTileTask(std::shared_ptr<MatrixTileJob<T>> job, size_t tile) : job_(std::move(job)), tile_(tile) {}
+
+    std::string GetName() const override { return "TaskB Matrix Tile"; }
+    TaskResult Run(const CancellationTokenPtr& token) override {
+        // ԼƱȡʱȡ˷
+        auto cb = token->Register([job = job_]() { job->token->Cancel(); });
+        const bool ran = job_->RunTile(tile_);
+        token->Unregister(cb);
+
+        if (job_->token->IsCancelled()) {
+            return TaskResult::Cancelled("Matrix tile " + std::to_string(tile_) + " cancelled");
+        }
+        return TaskResult::Success("Matrix tile " + std::to_string(tile_) + (ran ? " done" : " done by another worker"));
+    }
+
+private:
+    std::shared_ptr<MatrixTileJob<T>> job_;
+    size_t tile_;
+};
+
+template <class T>
+void FillRandom(std::mt19937& rng, T* data, size_t count) {
+    if constexpr (std::is_integral_v<T>) {
+        std::uniform_int_distribution<int32_t> dist(-8, 8);
+        for (size_t i = 0; i < count; ++i) data[i] = dist(rng);
+    }
+    else {
+        std::uniform_real_distribution<T> dist(T(0), T(1));
+        for (size_t i = 0; i < count; ++i) data[i] = dist(rng);
+    }
+}
+
+// ߵ·
+template <class T>
+std::string KernelName(size_t n) {
+    if (IsUnrolledMatrixSize(n)) return std::string(MatrixElementName<T>()) + ", unrolled";
+    if constexpr (std::is_same_v<T, double>) return Gemm::IsaName(Gemm::DetectIsa());
+    else return std::string(MatrixElementName<T>()) + ", blocked";
+}
+
+}
 
-    // ʹýСľȷ
-    const int N = 100;
-    std::vector<double> A(N * N), B(N * N), C(N * N, 0.0);
+template <class T>
+TaskResult BasicMatrixMultiplyTask<T>::Run(const CancellationTokenPtr& token) {
+    std::cout << "MatrixMultiplyTask::Run started" << std::endl;
+
+    const size_t N = size_;
+    std::vector<T> A(N * N), B(N * N), C(N * N);
 
     std::mt19937 rng(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
 
-    // ʼ
-    for (int i = 0; i < N * N; ++i) {
+    // ʼÿмһȡ
+    for (size_t i = 0; i < N; ++i) {
         if (token && token->IsCancelled()) {
             std::cout << "MatrixMultiplyTask cancelled during initialization" << std::endl;
-            return "Matrix calculation cancelled";
+            return TaskResult::Cancelled("Matrix calculation cancelled");
         }
-        A[i] = dist(rng);
-        B[i] = dist(rng);
+        FillRandom(rng, A.data() + i * N, N);
+        FillRandom(rng, B.data() + i * N, N);
     }
 
+    auto& scheduler = TaskScheduler::Instance();
+    const size_t workers = scheduler.WorkerCount();
     auto start = std::chrono::high_resolution_clock::now();
 
-    // ˷
-    for (int i = 0; i < N; ++i) {
-        if (token && token->IsCancelled()) {
-            std::cout << "MatrixMultiplyTask cancelled during calculation" << std::endl;
-            return "Matrix calculation cancelled";
-        }
-
-        for (int j = 0; j < N; ++j) {
-            double sum = 0.0;
-            for (int k = 0; k < N; ++k) {
-                sum += A[i * N + k] * B[k * N + j];
-            }
-            C[i * N + j] = sum;
+    size_t tiles = 1;
+    bool completed = true;
+    if (workers <= 1 || N < 2 * kTileCols || !token) {
+        // ̫Сֻһֱ̣߳ڵǰ̼߳㣻ںÿһһȡ
+        completed = MatrixMultiply(A.data(), B.data(), C.data(), N, token.get());
+    }
+    else {
+        auto job = std::make_shared<MatrixTileJob<T>>();
+        job->A = A.data();
+        job->B = B.data();
+        job->C = C.data();
+        job->n = N;
+        job->rowTiles = (N + kTileRows - 1) / kTileRows;
+        job->colTiles = (N + kTileCols - 1) / kTileCols;
+        job->token = token;
+        tiles = job->TileCount();
+        job->claimed = std::make_unique<std::atomic<bool>[]>(tiles);
+        for (size_t t = 0; t < tiles; ++t) job->claimed[t].store(false, std::memory_order_relaxed);
+
+        // ֿΪύй̻߳ȡͬʱ˳죬
+        // ߳ȫæδУʱɸ꣬ȴ
+        std::vector<std::shared_ptr<ITask>> subtasks;
+        subtasks.reserve(tiles);
+        for (size_t t = 0; t < tiles; ++t) subtasks.push_back(std::make_shared<MatrixTileTask<T>>(job, t));
+        scheduler.ExecuteBatch(std::move(subtasks));
+
+        for (size_t t = 0; t < tiles; ++t) job->RunTile(t);
+
+        // зֿ鶼죬߳ķֿͷ
+        {
+            std::unique_lock<std::mutex> lk(job->mtx);
+            job->cv.wait(lk, [&]() { return job->finished.load(std::memory_order_acquire) == tiles; });
         }
+        completed = !token->IsCancelled();
+    }
 
-        // ÿ10мһȡ
-        if (i % 10 == 0 && token && token->IsCancelled()) {
-            std::cout << "MatrixMultiplyTask cancelled during row " << i << std::endl;
-            return "Matrix calculation cancelled at row " + std::to_string(i);
-        }
+    if (!completed) {
+        std::cout << "MatrixMultiplyTask cancelled during calculation" << std::endl;
+        return TaskResult::Cancelled("Matrix calculation cancelled");
     }
 
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double gflops = seconds > 0 ? 2.0 * N * N * N / seconds / 1e9 : 0.0;
 
     // 
     double trace = 0.0;
-    for (int i = 0; i < N; ++i) {
-        trace += C[i * N + i];
+    for (size_t i = 0; i < N; ++i) {
+        trace += static_cast<double>(C[i * N + i]);
     }
 
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(2);
     oss << "Matrix " << N << "x" << N << " multiply completed in "
-        << duration.count() << "ms. Trace = " << trace;
+        << duration.count() << "ms (" << gflops << " GFLOP/s, " << KernelName<T>(N) << ", "
+        << tiles << (tiles == 1 ? " tile" : " tiles") << "). Trace = " << trace;
 
     std::cout << "MatrixMultiplyTask completed: " << oss.str() << std::endl;
-    return oss.str();
+    return TaskResult::Success(oss.str());
 }
 
+template <class T>
+TaskResult SmallMatrixBatchTask<T>::Run(const CancellationTokenPtr& token) {
+    switch (size_) {
+    case 8:  return RunFixed<8>(token);
+    case 16: return RunFixed<16>(token);
+    case 32: return RunFixed<32>(token);
+    case 64: return RunFixed<64>(token);
+    default:
+        return TaskResult::Failure("Small matrix batch error: size must be 8, 16, 32 or 64, got " + std::to_string(size_));
+    }
+}
+
+template <class T>
+template <size_t N>
+TaskResult SmallMatrixBatchTask<T>::RunFixed(const CancellationTokenPtr& token) {
+    std::cout << "SmallMatrixBatchTask::Run started" << std::endl;
+
+    std::mt19937 rng(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+    FixedMatrix<T, N> A, B, C;
+    FillRandom(rng, A.data(), A.size());
+    FillRandom(rng, B.data(), B.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double checksum = 0.0;
+    for (size_t r = 0; r < count_; ++r) {
+        if ((r & 4095) == 0 && token && token->IsCancelled()) {
+            std::cout << "SmallMatrixBatchTask cancelled after " << r << " multiplies" << std::endl;
+            return TaskResult::Cancelled("Small matrix batch cancelled after " + std::to_string(r) + " multiplies");
+        }
+        // ÿθһԪأ˷ܱᵽѭ
+        A[r % A.size()] += T(1);
+        MatrixMultiply<T, N>(A, B, C);
+        checksum += static_cast<double>(C[r % C.size()]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double perSecond = seconds > 0 ? static_cast<double>(count_) / seconds : 0.0;
+    const double gflops = seconds > 0 ? 2.0 * N * N * N * static_cast<double>(count_) / seconds / 1e9 : 0.0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << count_ << " multiplies of " << N << "x" << N << " " << MatrixElementName<T>() << " in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms ("
+        << perSecond / 1e6 << "M/s, " << gflops << " GFLOP/s). Checksum = " << checksum;
+
+    std::cout << "SmallMatrixBatchTask completed: " << oss.str() << std::endl;
+    return TaskResult::Success(oss.str());
+}
+
+template class BasicMatrixMultiplyTask<float>;
+template class BasicMatrixMultiplyTask<double>;
+template class BasicMatrixMultiplyTask<int32_t>;
+template class SmallMatrixBatchTask<float>;
+template class SmallMatrixBatchTask<double>;
+template class SmallMatrixBatchTask<int32_t>;
+
 // -------------------- TaskC: HTTP --------------------
-std::string HttpGetZenTask::Execute(const CancellationTokenPtr& token) {
-    std::cout << "HttpGetZenTask::Execute started" << std::endl;
+CoroutineTask::Body HttpGetZenTask::RunAsync(CancellationTokenPtr) {
+    std::cout << "HttpGetZenTask::RunAsync started" << std::endl;
 
     // ģӳ
     for (int i = 0; i < 3; i++) {
-        if (token && token->IsCancelled()) {
+        try {
+            co_await Delay(std::chrono::milliseconds(300));
+        }
+        catch (const TaskCancelledError&) {
             std::cout << "HttpGetZenTask cancelled" << std::endl;
-            return "HTTP request cancelled";
+            co_return TaskResult::Cancelled("HTTP request cancelled");
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
     }
 
     try {
@@ -178,79 +359,185 @@ std::string HttpGetZenTask::Execute(const CancellationTokenPtr& token) {
         }
 
         std::cout << "HttpGetZenTask completed: " << zenQuote << std::endl;
-        return "Zen quote saved to " + outFile_.string() + ": " + zenQuote;
+        co_return TaskResult::Success("Zen quote saved to " + outFile_.string() + ": " + zenQuote);
     }
     catch (const std::exception& e) {
         std::cout << "HttpGetZenTask error: " << e.what() << std::endl;
-        return "HTTP error: " + std::string(e.what());
+        co_return TaskResult::Failure("HTTP error: " + std::string(e.what()));
     }
 }
 
 // -------------------- TaskE: ͳ --------------------
-std::string RandomStatsTask::Execute(const CancellationTokenPtr& token) {
-    std::cout << "RandomStatsTask::Execute started" << std::endl;
+namespace {
+
+// ÿֿֿã, ֿţʼԼ棬ĸ̼߳޹
+constexpr uint64_t kStatsChunkSamples = uint64_t(1) << 22;
+// ɵջϵСۼӣҲǼȡļ
+constexpr size_t kStatsBlockSamples = 4096;
+
+// ͳһֿ飻ȡ falseʱ stats ֻ
+bool AccumulateRandomChunk(uint64_t seed, uint64_t chunk, uint64_t count, RunningStats& stats,
+    const CancellationToken* token) {
+    std::seed_seq seq{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+        static_cast<uint32_t>(chunk), static_cast<uint32_t>(chunk >> 32) };
+    std::mt19937_64 rng(seq);
+    std::uniform_int_distribution<int> dist(0, 100);
 
-    const int N = 500; // ȷ
-    std::vector<int> numbers;
-    numbers.reserve(N);
+    int block[kStatsBlockSamples];
+    for (uint64_t done = 0; done < count;) {
+        if (token && token->IsCancelled()) return false;
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(kStatsBlockSamples, count - done));
+        for (size_t i = 0; i < n; ++i) block[i] = dist(rng);
+        stats.AddRange(block, block + n);
+        done += n;
+    }
+    return true;
+}
 
-    std::mt19937 rng(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-    std::uniform_int_distribution<int> dist(0, 100);
+// һβͳƵĹ״ֿ̬鰴죬ֻһ
+// ڴռֿ޹أֿĲֽϲ stats
+struct RandomStatsJob {
+    uint64_t seed = 0;
+    uint64_t total = 0;
+    uint64_t chunks = 0;
+    CancellationTokenPtr token;  // ƣзֿ鹲
+
+    std::atomic<uint64_t> next{ 0 };
+    std::atomic<uint64_t> finished{ 0 };
+    std::mutex mtx;
+    std::condition_variable cv;
+    RunningStats stats;  //  mtx 
+
+    // 첢ͳƷֱֿȫꣻȡķֿ鲻ټ㣬ֻ
+    void Drain() {
+        for (;;) {
+            const uint64_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) return;
+
+            if (!token->IsCancelled()) {
+                const uint64_t begin = chunk * kStatsChunkSamples;
+                RunningStats partial;
+                if (AccumulateRandomChunk(seed, chunk, std::min(kStatsChunkSamples, total - begin), partial, token.get())) {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    stats.Merge(partial);
+                }
+            }
 
-    double sum = 0.0;
-    for (int i = 0; i < N; ++i) {
-        if (token && token->IsCancelled()) {
-            std::cout << "RandomStatsTask cancelled" << std::endl;
-            return "Random stats calculation cancelled";
+            if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard<std::mutex> lk(mtx);
+                cv.notify_all();
+            }
+        }
+    }
+};
+
+// ͳÿй߳һִֵʱֿѾ
+class RandomStatsChunkTask : public TypedTask {
+public:
+    explicit RandomStatsChunkTask(std::shared_ptr<RandomStatsJob> job) : job_(std::move(job)) {}
+
+    std::string GetName() const override { return "TaskE Random Stats Chunk"; }
+    TaskResult Run(const CancellationTokenPtr& token) override {
+        // ԼƱȡʱȡͳ
+        auto cb = token->Register([job = job_]() { job->token->Cancel(); });
+        job_->Drain();
+        token->Unregister(cb);
+
+        if (job_->token->IsCancelled()) {
+            return TaskResult::Cancelled("Random stats chunk cancelled");
         }
+        return TaskResult::Success("Random stats chunks drained");
+    }
 
-        int num = dist(rng);
-        numbers.push_back(num);
-        sum += num;
+private:
+    std::shared_ptr<RandomStatsJob> job_;
+};
 
-        // ÿ100һȡ
-        if (i % 100 == 0 && token && token->IsCancelled()) {
-            std::cout << "RandomStatsTask cancelled at iteration " << i << std::endl;
-            return "Random stats calculation cancelled at iteration " + std::to_string(i);
-        }
+}
+
+TaskResult RandomStatsTask::Run(const CancellationTokenPtr& token) {
+    std::cout << "RandomStatsTask::Run started" << std::endl;
+
+    const uint64_t N = count_;
+    if (N == 0) {
+        return TaskResult::Failure("Random stats error: count must be positive");
     }
 
-    double mean = sum / N;
+    const uint64_t seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    const uint64_t chunks = (N + kStatsChunkSamples - 1) / kStatsChunkSamples;
 
-    double variance = 0.0;
-    for (int i = 0; i < N; ++i) {
-        if (token && token->IsCancelled()) {
-            std::cout << "RandomStatsTask cancelled during variance calculation" << std::endl;
-            return "Random stats calculation cancelled";
+    auto& scheduler = TaskScheduler::Instance();
+    const size_t workers = scheduler.WorkerCount();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    RunningStats stats;
+    size_t helpers = 0;
+    bool completed = true;
+    if (workers <= 1 || chunks < 2 || !token) {
+        // ֻһ̣߳ڵǰ߳ͳ
+        for (uint64_t chunk = 0; chunk < chunks && completed; ++chunk) {
+            const uint64_t begin = chunk * kStatsChunkSamples;
+            completed = AccumulateRandomChunk(seed, chunk, std::min(kStatsChunkSamples, N - begin), stats, token.get());
         }
+    }
+    else {
+        auto job = std::make_shared<RandomStatsJob>();
+        job->seed = seed;
+        job->total = N;
+        job->chunks = chunks;
+        job->token = token;
+
+        // ̸߳һ񣬸ͬʱ죻
+        // ߳ȫæδУʱɸ꣬ȴ
+        helpers = static_cast<size_t>(std::min<uint64_t>(workers - 1, chunks - 1));
+        std::vector<std::shared_ptr<ITask>> subtasks;
+        subtasks.reserve(helpers);
+        for (size_t h = 0; h < helpers; ++h) subtasks.push_back(std::make_shared<RandomStatsChunkTask>(job));
+        scheduler.ExecuteBatch(std::move(subtasks));
+
+        job->Drain();
+
+        {
+            std::unique_lock<std::mutex> lk(job->mtx);
+            job->cv.wait(lk, [&]() { return job->finished.load(std::memory_order_acquire) == chunks; });
+            stats = job->stats;
+        }
+        completed = !token->IsCancelled();
+    }
 
-        double diff = numbers[i] - mean;
-        variance += diff * diff;
+    if (!completed) {
+        std::cout << "RandomStatsTask cancelled after " << stats.Count() << " samples" << std::endl;
+        return TaskResult::Cancelled("Random stats calculation cancelled after " + std::to_string(stats.Count()) + " samples");
     }
-    variance /= N;
 
-    double stddev = std::sqrt(variance);
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double perSecond = seconds > 0 ? static_cast<double>(N) / seconds : 0.0;
 
     // дļ
     std::ofstream ofs("random_stats.txt", std::ios::app);
     if (ofs) {
         ofs << "=== Random Statistics ===\n";
         ofs << "Time: " << GetCurrentDateTime() << "\n";
-        ofs << "Count: " << N << "\n";
+        ofs << "Count: " << stats.Count() << "\n";
         ofs << std::fixed << std::setprecision(4);
-        ofs << "Mean: " << mean << "\n";
-        ofs << "Variance: " << variance << "\n";
-        ofs << "Standard Deviation: " << stddev << "\n";
-        ofs << "Min: " << *std::min_element(numbers.begin(), numbers.end()) << "\n";
-        ofs << "Max: " << *std::max_element(numbers.begin(), numbers.end()) << "\n";
+        ofs << "Mean: " << stats.Mean() << "\n";
+        ofs << "Variance: " << stats.Variance() << "\n";
+        ofs << "Standard Deviation: " << stats.StdDev() << "\n";
+        ofs << std::setprecision(0);
+        ofs << "Min: " << stats.Min() << "\n";
+        ofs << "Max: " << stats.Max() << "\n";
         ofs << "=========================\n";
     }
 
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(4);
-    oss << "Generated " << N << " random numbers. ";
-    oss << "Mean: " << mean << ", Variance: " << variance << ", StdDev: " << stddev;
+    oss << "Generated " << N << " random numbers in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms ("
+        << std::setprecision(2) << perSecond / 1e6 << "M/s, " << helpers + 1
+        << (helpers == 0 ? " thread" : " threads") << "). " << std::setprecision(4);
+    oss << "Mean: " << stats.Mean() << ", Variance: " << stats.Variance() << ", StdDev: " << stats.StdDev();
 
     std::cout << "RandomStatsTask completed: " << oss.str() << std::endl;
-    return oss.str();
+    return TaskResult::Success(oss.str());
 }
\ No newline at end of file
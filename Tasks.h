@@ -1,48 +1,104 @@
 #pragma once
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include "ITask.h"
+#include "CoroutineTask.h"
 #include "CancellationToken.h"
+#include "MatrixMultiply.h"
 
-// TaskA: ļ
-class FileBackupTask : public ITask {
+// TaskA: ļݣЭ񣬵ȴڼ䲻ռụ̀߳
+class FileBackupTask : public CoroutineTask {
 public:
     FileBackupTask(std::filesystem::path src, std::filesystem::path dstDir)
         : src_(std::move(src)), dstDir_(std::move(dstDir)) {
     }
 
     std::string GetName() const override { return "TaskA File Backup"; }
-    std::string Execute(const CancellationTokenPtr& token) override;
+    std::string GetCoalescingKey() const override {
+        return GetName() + "|" + src_.string() + "|" + dstDir_.string();
+    }
+    Body RunAsync(CancellationTokenPtr token) override;
 
 private:
     std::filesystem::path src_;
     std::filesystem::path dstDir_;
 };
 
-// TaskB: ˷
-class MatrixMultiplyTask : public ITask {
+// TaskB: ˷Ԫͼ MatrixMultiply.hɷֿм
+template <class T>
+class BasicMatrixMultiplyTask : public TypedTask {
 public:
-    std::string GetName() const override { return "TaskB Matrix Multiply"; }
-    std::string Execute(const CancellationTokenPtr& token) override;
+    static constexpr size_t kDefaultSize = 100;
+
+    explicit BasicMatrixMultiplyTask(size_t size = kDefaultSize) : size_(size) {}
+
+    std::string GetName() const override {
+        if constexpr (std::is_same_v<T, double>) return "TaskB Matrix Multiply";
+        else return std::string("TaskB Matrix Multiply ") + MatrixElementName<T>();
+    }
+    std::string GetCoalescingKey() const override {
+        return GetName() + "|" + std::to_string(size_) + "x" + std::to_string(size_);
+    }
+    TaskResult Run(const CancellationTokenPtr& token) override;
+
+private:
+    size_t size_;
 };
 
-// TaskC: HTTP
-class HttpGetZenTask : public ITask {
+using MatrixMultiplyTask = BasicMatrixMultiplyTask<double>;
+
+// TaskB Сһ count  N x N ˷N Ϊ 8/16/32/64
+// ߱չںˣջϣΪÿγ˷ڴύ
+template <class T>
+class SmallMatrixBatchTask : public TypedTask {
+public:
+    SmallMatrixBatchTask(size_t size, size_t count) : size_(size), count_(count) {}
+
+    std::string GetName() const override {
+        return std::string("TaskB Small Matrix Batch ") + MatrixElementName<T>();
+    }
+    TaskResult Run(const CancellationTokenPtr& token) override;
+
+private:
+    template <size_t N>
+    TaskResult RunFixed(const CancellationTokenPtr& token);
+
+    size_t size_;
+    size_t count_;
+};
+
+extern template class BasicMatrixMultiplyTask<float>;
+extern template class BasicMatrixMultiplyTask<double>;
+extern template class BasicMatrixMultiplyTask<int32_t>;
+extern template class SmallMatrixBatchTask<float>;
+extern template class SmallMatrixBatchTask<double>;
+extern template class SmallMatrixBatchTask<int32_t>;
+
+// TaskC: HTTPЭ
+class HttpGetZenTask : public CoroutineTask {
 public:
     explicit HttpGetZenTask(std::filesystem::path outFile)
         : outFile_(std::move(outFile)) {
     }
 
     std::string GetName() const override { return "TaskC HTTP GET Zen"; }
-    std::string Execute(const CancellationTokenPtr& token) override;
+    Body RunAsync(CancellationTokenPtr token) override;
 
 private:
     std::filesystem::path outFile_;
 };
 
-// TaskE: ͳ
-class RandomStatsTask : public ITask {
+// TaskE: ͳƣʽۼӲcount Ե 10^10 ʱֿ齻߳
+class RandomStatsTask : public TypedTask {
 public:
+    static constexpr uint64_t kDefaultCount = 500;
+
+    explicit RandomStatsTask(uint64_t count = kDefaultCount) : count_(count) {}
+
     std::string GetName() const override { return "TaskE Random Stats"; }
-    std::string Execute(const CancellationTokenPtr& token) override;
+    TaskResult Run(const CancellationTokenPtr& token) override;
+
+private:
+    uint64_t count_;
 };
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(Clock::time_point start)
+    : epoch_(start), heads_(kLevels * kSlots + 1, kNil) {
+}
+
+uint64_t TimerWheel::ToTick(Clock::time_point tp) const {
+    if (tp <= epoch_) return 0;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(tp - epoch_).count());
+}
+
+uint64_t TimerWheel::ToTickCeil(Clock::time_point tp) const {
+    if (tp <= epoch_) return 0;
+    auto ms = std::chrono::ceil<std::chrono::milliseconds>(tp - epoch_).count();
+    return static_cast<uint64_t>(ms);
+}
+
+TimerWheel::Clock::time_point TimerWheel::FromTick(uint64_t tick) const {
+    return epoch_ + std::chrono::milliseconds(tick);
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(Clock::time_point due, Callback cb,
+    Clock::duration period, MissedPeriodPolicy policy) {
+    uint32_t idx;
+    if (freeHead_ != kNil) {
+        idx = freeHead_;
+        freeHead_ = nodes_[idx].next;
+    }
+    else {
+        idx = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& n = nodes_[idx];
+    n.due = ToTickCeil(due);
+    n.period = 0;
+    if (period > Clock::duration::zero()) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(period).count();
+        n.period = ms > 0 ? static_cast<uint64_t>(ms) : 1;
+    }
+    n.policy = policy;
+    n.cb = std::move(cb);
+    Link(idx);
+    ++count_;
+
+    return (static_cast<uint64_t>(n.gen) << 32) | (static_cast<uint64_t>(idx) + 1);
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+    if (id == kInvalidTimer) return false;
+    uint64_t slot = (id & 0xFFFFFFFFull);
+    if (slot == 0 || slot > nodes_.size()) return false;
+    uint32_t idx = static_cast<uint32_t>(slot - 1);
+    Node& n = nodes_[idx];
+    if (n.list == kNil || n.gen != static_cast<uint32_t>(id >> 32)) return false;
+
+    Unlink(idx);
+    Release(idx);
+    --count_;
+    return true;
+}
+
+void TimerWheel::Clear() {
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].list != kNil) {
+            Unlink(i);
+            Release(i);
+        }
+    }
+    count_ = 0;
+}
+
+void TimerWheel::Link(uint32_t idx) {
+    Node& n = nodes_[idx];
+    if (n.due < cur_) n.due = cur_;
+
+    // ѡ cur_ λͬһ
+    uint32_t list = kOverflowList;
+    for (int level = 0; level < kLevels; ++level) {
+        int shift = kSlotBits * (level + 1);
+        if ((n.due >> shift) == (cur_ >> shift)) {
+            list = level * kSlots + static_cast<uint32_t>((n.due >> (kSlotBits * level)) & (kSlots - 1));
+            break;
+        }
+    }
+
+    n.list = list;
+    n.prev = kNil;
+    n.next = heads_[list];
+    if (n.next != kNil) nodes_[n.next].prev = idx;
+    heads_[list] = idx;
+}
+
+void TimerWheel::Unlink(uint32_t idx) {
+    Node& n = nodes_[idx];
+    if (n.prev != kNil) nodes_[n.prev].next = n.next;
+    else heads_[n.list] = n.next;
+    if (n.next != kNil) nodes_[n.next].prev = n.prev;
+    n.prev = n.next = kNil;
+    n.list = kNil;
+}
+
+void TimerWheel::Release(uint32_t idx) {
+    Node& n = nodes_[idx];
+    n.cb = nullptr;
+    n.list = kNil;
+    ++n.gen;
+    n.next = freeHead_;
+    freeHead_ = idx;
+}
+
+uint64_t TimerWheel::NextEventTick() const {
+    if (count_ == 0) return UINT64_MAX;
+
+    // cur_ ͣڿ߽ʱÿڸ߲Ĳۿܻûм cur_ 
+    // 򱾿 0 Ķʱȵڣcur_ Խ߽߲ĶʱҲᴥ
+    if ((cur_ & 0xFFFFFFFFull) == 0 && heads_[kOverflowList] != kNil) return cur_;
+    for (int level = 1; level < kLevels; ++level) {
+        int shift = kSlotBits * level;
+        if ((cur_ & ((1ull << shift) - 1)) != 0) break;
+        if (heads_[level * kSlots + static_cast<uint32_t>((cur_ >> shift) & (kSlots - 1))] != kNil) return cur_;
+    }
+
+    //  0 㣺ǰ tick ڵ 256ms ڵĵڲ
+    uint64_t base = cur_ & ~static_cast<uint64_t>(kSlots - 1);
+    for (uint32_t s = static_cast<uint32_t>(cur_ & (kSlots - 1)); s < kSlots; ++s) {
+        if (heads_[s] != kNil) return base + s;
+    }
+
+    // ߲㣺һǿղۿʼʱ
+    for (int level = 1; level < kLevels; ++level) {
+        int shift = kSlotBits * level;
+        uint32_t digit = static_cast<uint32_t>((cur_ >> shift) & (kSlots - 1));
+        uint64_t high = (cur_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+        // cur_ ǡڿ߽ʱĲۻûм
+        uint32_t first = (cur_ & ((1ull << shift) - 1)) == 0 ? digit : digit + 1;
+        for (uint32_t s = first; s < kSlots; ++s) {
+            if (heads_[level * kSlots + s] != kNil) return high + (static_cast<uint64_t>(s) << shift);
+        }
+    }
+
+    if (heads_[kOverflowList] != kNil) {
+        const int shift = kSlotBits * kLevels;
+        if ((cur_ & ((1ull << shift) - 1)) == 0) return cur_;
+        return ((cur_ >> shift) + 1) << shift;
+    }
+    return UINT64_MAX;
+}
+
+TimerWheel::Clock::time_point TimerWheel::NextWakeup() const {
+    uint64_t tick = NextEventTick();
+    if (tick == UINT64_MAX) return Clock::time_point::max();
+    return FromTick(tick);
+}
+
+void TimerWheel::Cascade(uint32_t list) {
+    uint32_t idx = heads_[list];
+    heads_[list] = kNil;
+    while (idx != kNil) {
+        uint32_t next = nodes_[idx].next;
+        nodes_[idx].list = kNil;
+        Link(idx);
+        idx = next;
+    }
+}
+
+void TimerWheel::Expire(uint32_t list, uint64_t target, std::vector<Callback>& expired) {
+    uint32_t idx = heads_[list];
+    heads_[list] = kNil;
+    cur_ = cur_ + 1;  // ڶʱװʱܻصڴĲ
+
+    while (idx != kNil) {
+        Node& n = nodes_[idx];
+        uint32_t next = n.next;
+        n.list = kNil;
+        n.prev = n.next = kNil;
+
+        if (n.period == 0) {
+            expired.push_back(std::move(n.cb));
+            Release(idx);
+            --count_;
+        }
+        else {
+            expired.push_back(n.cb);
+            n.due += n.period;
+            // SkipʵƽʱΪ׼Ѿ
+            if (n.policy == MissedPeriodPolicy::Skip && n.due <= target) {
+                n.due += ((target - n.due) / n.period + 1) * n.period;
+            }
+            Link(idx);
+        }
+        idx = next;
+    }
+}
+
+void TimerWheel::Advance(Clock::time_point now, std::vector<Callback>& expired) {
+    const uint64_t target = ToTick(now);
+
+    while (true) {
+        uint64_t tick = NextEventTick();
+        if (tick > target) break;
+        cur_ = tick;
+
+        // Ӹ߲㵽ͲμڵĲ
+        if ((tick & 0xFFFFFFFFull) == 0) Cascade(kOverflowList);
+        for (int level = kLevels - 1; level >= 1; --level) {
+            int shift = kSlotBits * level;
+            if ((tick & ((1ull << shift) - 1)) == 0) {
+                Cascade(level * kSlots + static_cast<uint32_t>((tick >> shift) & (kSlots - 1)));
+            }
+        }
+        Expire(static_cast<uint32_t>(tick & (kSlots - 1)), target, expired);
+    }
+
+    if (target + 1 > cur_) cur_ = target + 1;
+}
\ No newline at end of file
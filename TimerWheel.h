@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ִʱĴʽ
+enum class MissedPeriodPolicy {
+    Skip,     // ڣ뵽һδڵ
+    CatchUp   // ִд
+};
+
+// ֲʱ֣4  x 256 ۣ1ms 
+// /ȡΪ O(1)౾ɵ÷
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;  // 0 ʾЧ
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId kInvalidTimer = 0;
+
+    explicit TimerWheel(Clock::time_point start = Clock::now());
+
+    // period Ϊ 0 ʾһԶʱڶʱװ id 
+    TimerId Schedule(Clock::time_point due, Callback cb,
+        Clock::duration period = Clock::duration::zero(),
+        MissedPeriodPolicy policy = MissedPeriodPolicy::Skip);
+    bool Cancel(TimerId id);
+    void Clear();
+
+    // ƽ nowѵڵĻص׷ӵ expiredִУ
+    void Advance(Clock::time_point now, std::vector<Callback>& expired);
+
+    // һҪѵʱ㣻ûжʱʱ Clock::time_point::max()
+    Clock::time_point NextWakeup() const;
+
+    size_t Size() const { return count_; }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr uint32_t kOverflowList = kLevels * kSlots;
+
+    struct Node {
+        uint64_t due = 0;      //  tick
+        uint64_t period = 0;   //  tick0 Ϊһ
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t list = kNil;  // ڲλkNil ʾУ
+        uint32_t gen = 1;
+        MissedPeriodPolicy policy = MissedPeriodPolicy::Skip;
+        Callback cb;
+    };
+
+    // ȡ tickڵǰʱ
+    uint64_t ToTick(Clock::time_point tp) const;
+    // ȡ tickڵʱ䣬ʱ due 
+    uint64_t ToTickCeil(Clock::time_point tp) const;
+    Clock::time_point FromTick(uint64_t tick) const;
+    uint64_t NextEventTick() const;
+
+    void Link(uint32_t idx);
+    void Unlink(uint32_t idx);
+    void Release(uint32_t idx);
+    void Cascade(uint32_t list);
+    void Expire(uint32_t list, uint64_t target, std::vector<Callback>& expired);
+
+    Clock::time_point epoch_;
+    uint64_t cur_ = 0;  // һ tick
+    size_t count_ = 0;
+
+    std::vector<Node> nodes_;
+    uint32_t freeHead_ = kNil;
+    std::vector<uint32_t> heads_;  // kLevels * kSlots  + 1 
+};
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::enabled_{ false };
+
+namespace {
+
+struct TraceRecord {
+    int64_t beginNs;
+    int64_t endNs;     // ˲ʱ¼ beginNs ͬ
+    uint64_t taskId;
+    uint64_t count;
+    NameId name;
+    TraceKind kind;
+};
+
+// ÿ߳һֻб߳дʱȡ
+struct ThreadTrace {
+    std::mutex mtx;
+    uint32_t tid = 0;
+    std::string name;
+    std::vector<TraceRecord> ring;
+    uint64_t written = 0;
+    uint64_t generation = 0;  //  Start Ĵͬʱ
+};
+
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::shared_ptr<ThreadTrace>> threads;
+    std::atomic<size_t> capacity{ 64 * 1024 };
+    std::atomic<uint64_t> generation{ 0 };
+    std::atomic<uint32_t> nextTid{ 1 };
+};
+
+Registry& Instance() {
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+ThreadTrace& Local() {
+    // ߳˳󻺳ɵǼǱУʱ¼
+    thread_local std::shared_ptr<ThreadTrace> local;
+    if (!local) {
+        Registry& r = Instance();
+        local = std::make_shared<ThreadTrace>();
+        local->tid = r.nextTid.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(r.mtx);
+        r.threads.push_back(local);
+    }
+    return *local;
+}
+
+int64_t ToNs(TraceRecorder::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+void Push(const TraceRecord& rec) {
+    Registry& r = Instance();
+    ThreadTrace& t = Local();
+    std::lock_guard<std::mutex> lk(t.mtx);
+    const uint64_t generation = r.generation.load(std::memory_order_acquire);
+    if (t.generation != generation) {
+        t.generation = generation;
+        t.written = 0;
+        t.ring.assign(r.capacity.load(std::memory_order_relaxed), TraceRecord{});
+    }
+    if (t.ring.empty()) return;
+    t.ring[t.written % t.ring.size()] = rec;
+    ++t.written;
+}
+
+const char* KindName(TraceKind kind) {
+    switch (kind) {
+    case TraceKind::Enqueue:  return "enqueue";
+    case TraceKind::Run:      return "run";
+    case TraceKind::Cancel:   return "cancel";
+    case TraceKind::Reject:   return "reject";
+    case TraceKind::Dispatch: return "dispatch";
+    }
+    return "unknown";
+}
+
+void AppendJsonString(std::string_view s, std::string& out) {
+    out += '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        }
+        else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void AppendMicros(int64_t ns, std::string& out) {
+    // trace-event ʱ䵥λ΢룬
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%03lld", static_cast<long long>(ns / 1000),
+        static_cast<long long>(ns % 1000));
+    out += buf;
+}
+
+}  // namespace
+
+void TraceRecorder::Start(size_t eventsPerThread) {
+    Registry& r = Instance();
+    r.capacity.store(eventsPerThread, std::memory_order_relaxed);
+    r.generation.fetch_add(1, std::memory_order_acq_rel);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::Stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::SetThreadName(std::string_view name) {
+    ThreadTrace& t = Local();
+    std::lock_guard<std::mutex> lk(t.mtx);
+    t.name.assign(name.data(), name.size());
+}
+
+void TraceRecorder::Instant(TraceKind kind, NameId name, uint64_t taskId, Clock::time_point at) {
+    if (!Enabled()) return;
+    const int64_t ns = ToNs(at);
+    Push({ ns, ns, taskId, 0, name, kind });
+}
+
+void TraceRecorder::Span(TraceKind kind, NameId name, uint64_t taskId, Clock::time_point begin,
+    Clock::time_point end, uint64_t count) {
+    if (!Enabled()) return;
+    Push({ ToNs(begin), ToNs(end), taskId, count, name, kind });
+}
+
+bool TraceRecorder::WriteChromeJson(const std::filesystem::path& path) {
+    Registry& r = Instance();
+    std::vector<std::shared_ptr<ThreadTrace>> threads;
+    {
+        std::lock_guard<std::mutex> lk(r.mtx);
+        threads = r.threads;
+    }
+    const uint64_t generation = r.generation.load(std::memory_order_acquire);
+
+    // ȸƸ̵߳ļ¼дļʱ̵߳
+    struct Copy {
+        uint32_t tid;
+        std::string name;
+        std::vector<TraceRecord> records;
+    };
+    std::vector<Copy> copies;
+    int64_t origin = INT64_MAX;
+    for (const auto& t : threads) {
+        std::lock_guard<std::mutex> lk(t->mtx);
+        if (t->generation != generation || t->written == 0) continue;
+        Copy c{ t->tid, t->name, {} };
+        const uint64_t n = std::min<uint64_t>(t->written, t->ring.size());
+        c.records.reserve(static_cast<size_t>(n));
+        for (uint64_t i = t->written - n; i < t->written; ++i) {
+            c.records.push_back(t->ring[i % t->ring.size()]);
+            origin = std::min(origin, c.records.back().beginNs);
+        }
+        copies.push_back(std::move(c));
+    }
+
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out += ",\n";
+        first = false;
+    };
+    for (const auto& c : copies) {
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(c.tid);
+        out += ",\"args\":{\"name\":";
+        AppendJsonString(c.name.empty() ? "Thread " + std::to_string(c.tid) : c.name, out);
+        out += "}}";
+
+        for (const auto& rec : c.records) {
+            separator();
+            const bool instant = rec.kind == TraceKind::Enqueue || rec.kind == TraceKind::Cancel
+                || rec.kind == TraceKind::Reject;
+            out += "{\"name\":";
+            if (rec.kind == TraceKind::Dispatch) {
+                AppendJsonString("dispatch", out);
+            }
+            else if (instant) {
+                AppendJsonString(std::string(KindName(rec.kind)) + ": " + TaskNames::Get(rec.name), out);
+            }
+            else {
+                AppendJsonString(TaskNames::Get(rec.name), out);
+            }
+            out += ",\"cat\":\"";
+            out += KindName(rec.kind);
+            out += instant ? "\",\"ph\":\"i\",\"s\":\"t\"" : "\",\"ph\":\"X\"";
+            out += ",\"pid\":1,\"tid\":";
+            out += std::to_string(c.tid);
+            out += ",\"ts\":";
+            AppendMicros(rec.beginNs - origin, out);
+            if (!instant) {
+                out += ",\"dur\":";
+                AppendMicros(rec.endNs - rec.beginNs, out);
+            }
+            out += ",\"args\":{";
+            if (rec.kind == TraceKind::Dispatch) {
+                out += "\"events\":";
+                out += std::to_string(rec.count);
+            }
+            else {
+                out += "\"task\":";
+                out += std::to_string(rec.taskId);
+            }
+            out += "}}";
+
+            if (out.size() > (1 << 20)) {
+                ofs.write(out.data(), static_cast<std::streamsize>(out.size()));
+                out.clear();
+            }
+        }
+    }
+    out += "\n]}\n";
+    ofs.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(ofs);
+}
\ No newline at end of file
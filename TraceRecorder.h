@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include "TaskNames.h"
+
+enum class TraceKind : uint8_t {
+    Enqueue,   // ύ˲ʱ¼
+    Run,       // ڹִ߳еһΣЭÿλָһΣ
+    Cancel,    // ȡ˲ʱ¼
+    Reject,    // ܾ˲ʱ¼
+    Dispatch,  // ̴ַ߳һ¼
+};
+
+// ĸټ¼Ϊ Chrome trace-event JSONPerfetto / about:tracing ֱӴ򿪣
+// ÿ߳дԼĻλδʱÿֻһ relaxed ԭӱ
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // м¼ʼeventsPerThread ÿ̻߳λд󸲸ɵ
+    static void Start(size_t eventsPerThread = 64 * 1024);
+    static void Stop();
+
+    // 㴦ж Enabled()δʱȡʱ
+    // ʱΪ߳δʱ̱߳
+    static void SetThreadName(std::string_view name);
+
+    static void Instant(TraceKind kind, NameId name, uint64_t taskId, Clock::time_point at);
+    static void Span(TraceKind kind, NameId name, uint64_t taskId, Clock::time_point begin, Clock::time_point end,
+        uint64_t count = 0);
+
+    // д̵߳ǰе¼ڼ¼е
+    static bool WriteChromeJson(const std::filesystem::path& path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
\ No newline at end of file
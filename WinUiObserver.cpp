@@ -1,32 +1,54 @@
 #include "WinUiObserver.h"
+#include <chrono>
 #include <iostream>
 
 void WinUiObserver::OnTaskEvent(const TaskEvent& e) {
-    std::cout << "WinUiObserver::OnTaskEvent - Task: " << e.taskName
-        << ", Type: " << static_cast<int>(e.type)
-        << ", Message: " << e.message << std::endl;
+    // Ƚ̰߳֡Ͷ
+    batcher_.OnTaskEvent(e);
+}
+
+void WinUiObserver::OnEventBatch(EventBatch& batch) {
+    std::cout << "WinUiObserver::OnEventBatch - " << batch.events.size() << " events";
+    if (batch.dropped > 0) {
+        std::cout << ", " << batch.dropped << " dropped";
+    }
+    std::cout << std::endl;
 
     if (!hwnd_) {
-        std::cout << "WinUiObserver::OnTaskEvent - hwnd_ is null!" << std::endl;
+        std::cout << "WinUiObserver::OnEventBatch - hwnd_ is null!" << std::endl;
         return;
     }
 
     if (!IsWindow(hwnd_)) {
-        std::cout << "WinUiObserver::OnTaskEvent - hwnd_ is not a valid window!" << std::endl;
+        std::cout << "WinUiObserver::OnEventBatch - hwnd_ is not a valid window!" << std::endl;
         return;
     }
 
-    auto* payload = new UiEventPayload{ e };
+    auto* payload = new UiEventBatch{ std::move(batch.events), {}, batch.dropped };
+    payload->messages.reserve(payload->events.size());
+    for (const auto& e : payload->events) {
+        payload->messages.push_back(e.Message());
+    }
 
-    // ϢUI߳
+    // һֻһϢUI߳
     BOOL result = PostMessageW(hwnd_, WM_APP_TASK_EVENT, 0, reinterpret_cast<LPARAM>(payload));
 
     if (!result) {
         DWORD error = GetLastError();
-        std::cout << "WinUiObserver::OnTaskEvent - PostMessageW failed! Error: " << error << std::endl;
+        std::cout << "WinUiObserver::OnEventBatch - PostMessageW failed! Error: " << error << std::endl;
         delete payload;
     }
-    else {
-        std::cout << "WinUiObserver::OnTaskEvent - Message posted successfully" << std::endl;
-    }
+}
+
+void WinUiObserver::OnQueueFull(const QueueFullEvent& e) {
+    // ֻʱģܾʾб
+    if (e.action == QueueFullAction::Blocked) return;
+
+    TaskEvent te;
+    te.type = TaskEventType::Failed;
+    te.name = e.name;
+    te.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    te.message = MessagePool::Store(e.action == QueueFullAction::Dropped ? "Dropped: queue full" : "Rejected: queue full");
+    OnTaskEvent(te);
 }
\ No newline at end of file
@@ -1,18 +1,31 @@
 #pragma once
 #include <Windows.h>
+#include <string>
+#include <vector>
 #include "ITaskObserver.h"
+#include "EventBatcher.h"
 
 constexpr UINT WM_APP_TASK_EVENT = WM_APP + 1;
 
-struct UiEventPayload {
-    TaskEvent e;
+// ÿ֡һ WM_APP_TASK_EVENTlParam ָһ¼ɽ߳ͷ
+// ϢıͶǰȡ̴߳ʱϢزλѱ
+struct UiEventBatch {
+    std::vector<TaskEvent> events;
+    std::vector<std::string> messages;  //  events һһӦ
+    uint64_t dropped = 0;
 };
 
-class WinUiObserver : public ITaskObserver {
+class WinUiObserver : public ITaskObserver, private IEventBatchSink {
 public:
-    explicit WinUiObserver(HWND hwnd) : hwnd_(hwnd) {}
+    explicit WinUiObserver(HWND hwnd) : hwnd_(hwnd), batcher_(*this) {}
+    ~WinUiObserver() override { batcher_.Stop(); }
+
     void OnTaskEvent(const TaskEvent& e) override;
+    void OnQueueFull(const QueueFullEvent& e) override;
 
 private:
+    void OnEventBatch(EventBatch& batch) override;
+
     HWND hwnd_{ nullptr };
+    EventBatcher batcher_;
 };
\ No newline at end of file
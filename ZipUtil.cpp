@@ -36,6 +36,34 @@ static void SafeRelease(IUnknown* p) {
     if (p) p->Release();
 }
 
+// ÿ´ zip Ŀ CopyHere ֮ǰõ Folderʧܷ -1
+static long CountZipItems(IShellDispatch* shell, const std::filesystem::path& zipPath) {
+    VARIANT vZip; VariantInit(&vZip);
+    vZip.vt = VT_BSTR;
+    vZip.bstrVal = SysAllocString(zipPath.wstring().c_str());
+
+    long count = -1;
+    Folder* folder = nullptr;
+    FolderItems* items = nullptr;
+    if (SUCCEEDED(shell->NameSpace(vZip, &folder)) && folder
+        && SUCCEEDED(folder->Items(&items)) && items) {
+        if (FAILED(items->get_Count(&count))) count = -1;
+    }
+    SafeRelease(items);
+    SafeRelease(folder);
+    VariantClear(&vZip);
+    return count;
+}
+
+// д zip ڼһֱռļܶռ˵Ѿд
+static bool CanOpenExclusive(const std::filesystem::path& path) {
+    HANDLE h = CreateFileW(path.wstring().c_str(), GENERIC_READ, 0, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    CloseHandle(h);
+    return true;
+}
+
 bool ZipDirectoryShell(const std::filesystem::path& sourceDir,
     const std::filesystem::path& zipPath,
     std::string* errMsg) {
@@ -106,6 +134,9 @@ bool ZipDirectoryShell(const std::filesystem::path& sourceDir,
             return false;
         }
 
+        long expected = 0;
+        if (FAILED(items->get_Count(&expected))) expected = 0;
+
         // CopyHere(items, options)
         VARIANT vItems; VariantInit(&vItems);
         vItems.vt = VT_DISPATCH;
@@ -126,22 +157,26 @@ bool ZipDirectoryShell(const std::filesystem::path& sourceDir,
         SafeRelease(items);
         SafeRelease(srcFolder);
         SafeRelease(zipFolder);
-        SafeRelease(shell);
 
         if (FAILED(hr)) {
+            SafeRelease(shell);
             if (errMsg) *errMsg = "CopyHere failed.";
             return false;
         }
 
-        // ȴѹ
-        auto lastSize = std::filesystem::file_size(zipPath);
-        for (int i = 0; i < 50; ++i) {
+        // CopyHere 첽ģļС䲻д꣨տʼʱһֱ 22 ֽڵĿ zip
+        // ´򿪵 zip ȫĿѾſļǰ COM ܷʼ
+        bool done = false;
+        for (int i = 0; i < 600 && !done; ++i) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            auto sz = std::filesystem::file_size(zipPath);
-            if (sz == lastSize) break;
-            lastSize = sz;
+            done = CountZipItems(shell, zipPath) >= expected && CanOpenExclusive(zipPath);
         }
+        SafeRelease(shell);
 
+        if (!done) {
+            if (errMsg) *errMsg = "Timed out waiting for CopyHere to finish.";
+            return false;
+        }
         return true;
     }
     catch (const std::exception& ex) {
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <string>
 
+//  sourceDir ѹ zipPathȵ zip ȫĿļдŷ
 bool ZipDirectoryShell(const std::filesystem::path& sourceDir,
     const std::filesystem::path& zipPath,
     std::string* errMsg = nullptr);
\ No newline at end of file
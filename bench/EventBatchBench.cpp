@@ -0,0 +1,118 @@
+// ¼׼ڣ HeadlessBatchSink  EventBatcher Σ˶ԺϲЧ
+// ÷EventBatchBench [ÿ¼] []
+// к¼ƵʱСһ֡ +  = ¼
+// һʧʱ 1
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../EventBatcher.h"
+#include "../HeadlessBatchSink.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct ScenarioResult {
+    std::string name;
+    size_t sent = 0;
+    HeadlessBatchSink::Stats stats;
+    bool ok = false;
+};
+
+static double Ms(std::chrono::nanoseconds ns) {
+    return std::chrono::duration<double, std::milli>(ns).count();
+}
+
+static TaskEvent MakeEvent(uint64_t id) {
+    TaskEvent e;
+    e.type = TaskEventType::Succeeded;
+    e.taskId = id;
+    e.timestampNs = Clock::now().time_since_epoch().count();
+    return e;
+}
+
+// ֡¼һ֡
+static ScenarioResult RunIdle(const EventBatcherOptions& options) {
+    ScenarioResult r;
+    r.name = "idle";
+    HeadlessBatchSink sink;
+    {
+        EventBatcher batcher(sink, options);
+        batcher.OnTaskEvent(MakeEvent(1));
+        std::this_thread::sleep_for(options.frameInterval * 3);
+        batcher.OnTaskEvent(MakeEvent(2));
+        std::this_thread::sleep_for(options.frameInterval * 3);
+        batcher.Stop();
+    }
+    r.sent = 2;
+    r.stats = sink.GetStats();
+    r.ok = r.stats.batches == 2 && r.stats.maxBatch == 1 && r.stats.maxLatency < options.frameInterval;
+    return r;
+}
+
+// ߳¼¼ٸһ֡
+static ScenarioResult RunBurst(const char* name, const EventBatcherOptions& options, size_t producers,
+    size_t perProducer, bool paced) {
+    ScenarioResult r;
+    r.name = name;
+    HeadlessBatchSink sink;
+    {
+        EventBatcher batcher(sink, options);
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for (size_t i = 0; i < perProducer; ++i) {
+                    batcher.OnTaskEvent(MakeEvent(p * perProducer + i));
+                    // Լÿ 64 ¼ٶȷԽ֡
+                    if (paced && (i & 63) == 63) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        // Stop ǰʣ¼ȵһ֡ȥζ֡
+        std::this_thread::sleep_for(options.frameInterval * 3);
+        batcher.Stop();
+    }
+    r.sent = producers * perProducer;
+    r.stats = sink.GetStats();
+
+    const bool conserved = r.stats.events + r.stats.dropped == r.sent;
+    const bool coalesced = r.stats.batches < r.sent;
+    const bool framed = r.stats.batches < 2 || r.stats.minInterval >= options.frameInterval;
+    r.ok = conserved && coalesced && framed;
+    return r;
+}
+
+int main(int argc, char** argv) {
+    size_t perProducer = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 20000;
+    size_t producers = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 4;
+    if (perProducer == 0) perProducer = 1;
+    if (producers == 0) producers = 1;
+
+    EventBatcherOptions options;
+
+    // С֡ܳȻ¼Ҫﱨ
+    EventBatcherOptions tiny;
+    tiny.capacity = 256;
+    tiny.frameInterval = std::chrono::milliseconds(50);
+
+    std::vector<ScenarioResult> results;
+    results.push_back(RunIdle(options));
+    results.push_back(RunBurst("burst", options, producers, perProducer, true));
+    results.push_back(RunBurst("overflow", tiny, producers, perProducer, false));
+    auto& overflow = results.back();
+    overflow.ok = overflow.ok && (overflow.sent <= tiny.capacity || overflow.stats.dropped > 0);
+
+    std::printf("%-10s %9s %8s %9s %9s %13s %14s %6s\n", "scenario", "sent", "batches", "maxBatch", "dropped",
+        "maxLat(ms)", "minGap(ms)", "check");
+    bool allOk = true;
+    for (const auto& r : results) {
+        std::printf("%-10s %9zu %8zu %9zu %9llu %13.2f %14.2f %6s\n", r.name.c_str(), r.sent, r.stats.batches,
+            r.stats.maxBatch, static_cast<unsigned long long>(r.stats.dropped), Ms(r.stats.maxLatency),
+            Ms(r.stats.minInterval), r.ok ? "ok" : "FAIL");
+        allOk = allOk && r.ok;
+    }
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+// ׼TestTaskCPU/IO ϡȡ籩ڲͬ߳²¡Ŷӵȴλ
+// ÷SchedulerBench [--workers 1,2,4,8] [--tasks 20000] [--duration-ms 20] [--json ļ]
+//  JSON Ĭд׼ںһжԱ
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../TaskScheduler.h"
+#include "../TestTask.h"
+
+using Clock = std::chrono::steady_clock;
+
+class NoopTask : public TypedTask {
+public:
+    std::string GetName() const override { return "bench.noop"; }
+    TaskResult Run(const CancellationTokenPtr&) override { return TaskResult::Success({}); }
+};
+
+// CPU ͣæ spinUs ΢
+class SpinTask : public TypedTask {
+public:
+    explicit SpinTask(int spinUs) : spinUs_(spinUs) {}
+    std::string GetName() const override { return "bench.cpu"; }
+    TaskResult Run(const CancellationTokenPtr& token) override {
+        auto until = Clock::now() + std::chrono::microseconds(spinUs_);
+        volatile uint64_t x = 1;
+        while (Clock::now() < until && !token->IsCancelled()) {
+            for (int i = 0; i < 256; ++i) x = x * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        return TaskResult::Success({});
+    }
+
+private:
+    int spinUs_;
+};
+
+// ȡ籩ãһֱȵȡȡӷ·
+class WaitForCancelTask : public TypedTask {
+public:
+    std::string GetName() const override { return "bench.cancel"; }
+    TaskResult Run(const CancellationTokenPtr& token) override {
+        token->WaitFor(std::chrono::seconds(30));
+        return TaskResult::Cancelled("cancelled");
+    }
+};
+
+// I/O ͣЭ̹ȴռù߳
+class IoTask : public CoroutineTask {
+public:
+    explicit IoTask(int waitMs) : waitMs_(waitMs) {}
+    std::string GetName() const override { return "bench.io"; }
+    Body RunAsync(CancellationTokenPtr) override {
+        co_await Delay(std::chrono::milliseconds(waitMs_));
+        co_return TaskResult::Success({});
+    }
+
+private:
+    int waitMs_;
+};
+
+struct BenchOptions {
+    std::vector<size_t> workers;
+    size_t tasks = 20000;
+    int durationMs = 20;
+};
+
+struct BenchResult {
+    std::string workload;
+    size_t workers = 0;
+    size_t tasks = 0;
+    double wallMs = 0;
+    double tasksPerSec = 0;
+    double overheadNsPerTask = 0;  // ߳æµʱвĲ֣̯ÿ
+    LatencySummary queueWait;
+    LatencySummary run;
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    uint64_t cancelled = 0;
+    uint64_t rejected = 0;
+    double cancelLatencyMs = -1;  // ֻȡ籩
+};
+
+// ѱ͵ͳƺϲһֱͼͰϲȡλ
+static void Collect(BenchResult& r, const SchedulerSnapshot& before, const SchedulerSnapshot& after) {
+    const TaskLatencyReport total = TaskScheduler::Instance().LatencyTotal();
+    r.queueWait = total.queueWait;
+    r.run = total.run;
+
+    r.succeeded = after.succeeded - before.succeeded;
+    r.failed = after.failed - before.failed;
+    r.cancelled = after.cancelled - before.cancelled;
+    r.rejected = after.rejected - before.rejected;
+    r.tasksPerSec = r.wallMs > 0 ? static_cast<double>(r.tasks) * 1000.0 / r.wallMs : 0;
+
+    // ֻ߳æµʱ䣬еȴ㿪
+    // Эڼ䲻ռụ̀߳run ʱֻͬ۳
+    double busyNs = 0;
+    for (size_t i = 0; i < after.workers.size(); ++i) {
+        auto busy = after.workers[i].busyTotal;
+        if (i < before.workers.size()) busy -= before.workers[i].busyTotal;
+        busyNs += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count());
+    }
+    const double runSumNs = r.run.meanNs * static_cast<double>(r.run.count);
+    if (r.tasks > 0 && r.workload != "mixed") {
+        r.overheadNsPerTask = std::max(0.0, (busyNs - runSumNs) / static_cast<double>(r.tasks));
+    }
+}
+
+template <class MakeTask>
+static BenchResult RunWorkload(const char* workload, size_t workers, size_t tasks, MakeTask make) {
+    auto& scheduler = TaskScheduler::Instance();
+    scheduler.Start(nullptr, workers);
+    scheduler.ResetLatency();
+
+    std::vector<std::shared_ptr<ITask>> batch;
+    batch.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) batch.push_back(make(i));
+
+    std::fprintf(stderr, "%s workers=%zu tasks=%zu\n", workload, workers, tasks);
+    BenchResult r;
+    r.workload = workload;
+    r.workers = workers;
+    r.tasks = tasks;
+
+    auto before = scheduler.Snapshot();
+    auto start = Clock::now();
+    std::vector<TaskHandle> handles;
+    handles.reserve(tasks);
+    for (auto& task : batch) handles.push_back(scheduler.ExecuteImmediately(std::move(task)));
+    for (auto& h : handles) h.Wait();
+    r.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Stop ֮¼ȫַ֪꣬ͨʱҲѼ
+    auto after = scheduler.Snapshot();
+    scheduler.Stop();
+    Collect(r, before, after);
+    return r;
+}
+
+static BenchResult RunCancelStorm(size_t workers, size_t tasks) {
+    auto& scheduler = TaskScheduler::Instance();
+    scheduler.Start(nullptr, workers);
+    scheduler.ResetLatency();
+
+    std::fprintf(stderr, "cancel-storm workers=%zu tasks=%zu\n", workers, tasks);
+    BenchResult r;
+    r.workload = "cancel-storm";
+    r.workers = workers;
+    r.tasks = tasks;
+
+    auto before = scheduler.Snapshot();
+    auto start = Clock::now();
+    std::vector<TaskHandle> handles;
+    handles.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) {
+        handles.push_back(scheduler.ExecuteImmediately(std::make_shared<WaitForCancelTask>()));
+    }
+
+    // ȹ̶߳ʼִк󣬴Ӷ߳ͬʱȡȫ
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto cancelStart = Clock::now();
+    std::vector<std::thread> cancellers;
+    const size_t cancellerCount = 4;
+    for (size_t c = 0; c < cancellerCount; ++c) {
+        cancellers.emplace_back([&, c]() {
+            for (size_t i = c; i < handles.size(); i += cancellerCount) handles[i].Cancel();
+        });
+    }
+    for (auto& t : cancellers) t.join();
+    for (auto& h : handles) h.Wait();
+    auto end = Clock::now();
+    r.cancelLatencyMs = std::chrono::duration<double, std::milli>(end - cancelStart).count();
+    r.wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    auto after = scheduler.Snapshot();
+    scheduler.Stop();
+    Collect(r, before, after);
+    r.overheadNsPerTask = 0;  // ;ȡ۳ִʱû
+    return r;
+}
+
+static void AppendSummary(std::ostringstream& out, const char* key, const LatencySummary& s) {
+    out << "\"" << key << "\":{\"count\":" << s.count << ",\"meanUs\":" << s.meanNs / 1000.0
+        << ",\"p50Us\":" << s.p50Ns / 1000.0 << ",\"p99Us\":" << s.p99Ns / 1000.0
+        << ",\"p999Us\":" << s.p999Ns / 1000.0 << ",\"maxUs\":" << s.maxNs / 1000.0 << "}";
+}
+
+static std::string ToJson(const BenchOptions& opts, const std::vector<BenchResult>& results) {
+    std::ostringstream out;
+    out << "{\n  \"benchmark\": \"SchedulerBench\",\n  \"hardwareThreads\": " << std::thread::hardware_concurrency()
+        << ",\n  \"tasks\": " << opts.tasks << ",\n  \"durationMs\": " << opts.durationMs << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "    {\"workload\":\"" << r.workload << "\",\"workers\":" << r.workers << ",\"tasks\":" << r.tasks
+            << ",\"wallMs\":" << r.wallMs << ",\"tasksPerSec\":" << r.tasksPerSec
+            << ",\"overheadNsPerTask\":" << r.overheadNsPerTask << ",";
+        AppendSummary(out, "queueWait", r.queueWait);
+        out << ",";
+        AppendSummary(out, "run", r.run);
+        out << ",\"succeeded\":" << r.succeeded << ",\"failed\":" << r.failed << ",\"cancelled\":" << r.cancelled << ",\"rejected\":" << r.rejected;
+        if (r.cancelLatencyMs >= 0) out << ",\"cancelLatencyMs\":" << r.cancelLatencyMs;
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+static std::vector<size_t> ParseList(const char* text) {
+    std::vector<size_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t v = static_cast<size_t>(std::strtoull(item.c_str(), nullptr, 10));
+        if (v > 0) values.push_back(v);
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) opts.workers = ParseList(argv[++i]);
+        else if (std::strcmp(argv[i], "--tasks") == 0 && i + 1 < argc) opts.tasks = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--duration-ms") == 0 && i + 1 < argc) opts.durationMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else {
+            std::fprintf(stderr, "Usage: SchedulerBench [--workers 1,2,4,8] [--tasks N] [--duration-ms D] [--json file]\n");
+            return 2;
+        }
+    }
+    if (opts.workers.empty()) opts.workers = { 1, 2, 4, 8 };
+    if (opts.tasks == 0) opts.tasks = 1;
+    if (opts.durationMs < 10) opts.durationMs = 10;  // TestTask  10 ˯
+
+    // Ŀ̨ĬϹرգӰ죻ֻͣʱļУָɾд stderr
+    std::streambuf* coutBuf = std::cout.rdbuf(nullptr);
+
+    std::vector<BenchResult> results;
+    for (size_t workers : opts.workers) {
+
+        results.push_back(RunWorkload("noop", workers, opts.tasks,
+            [](size_t) { return std::make_shared<NoopTask>(); }));
+
+        // ˯߳ţÿԼ 20 ʱ
+        const size_t sleepers = workers * 20;
+        const int duration = opts.durationMs;
+        results.push_back(RunWorkload("testtask", workers, sleepers,
+            [duration](size_t) { return std::make_shared<TestTask>("bench", duration); }));
+
+        // һ CPU 200usһЭ I/O
+        const size_t mixed = std::min<size_t>(opts.tasks, workers * 500);
+        results.push_back(RunWorkload("mixed", workers, mixed,
+            [duration](size_t i) -> std::shared_ptr<ITask> {
+                if (i % 2 == 0) return std::make_shared<SpinTask>(200);
+                return std::make_shared<IoTask>(duration);
+            }));
+
+        results.push_back(RunCancelStorm(workers, std::min<size_t>(opts.tasks, 2000)));
+    }
+
+    std::cout.rdbuf(coutBuf);
+
+    const std::string json = ToJson(opts, results);
+    if (jsonPath) {
+        std::ofstream ofs(jsonPath, std::ios::binary | std::ios::trunc);
+        ofs << json;
+        std::fprintf(stderr, "Results written to %s\n", jsonPath);
+    }
+    else {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+    }
+
+    std::fprintf(stderr, "%-13s %7s %8s %12s %14s %12s %12s\n", "workload", "workers", "tasks", "tasks/s",
+        "overhead(ns)", "wait p50(us)", "wait p99(us)");
+    for (const auto& r : results) {
+        std::fprintf(stderr, "%-13s %7zu %8zu %12.0f %14.0f %12.1f %12.1f\n", r.workload.c_str(), r.workers, r.tasks,
+            r.tasksPerSec, r.overheadNsPerTask, r.queueWait.p50Ns / 1000.0, r.queueWait.p99Ns / 1000.0);
+    }
+    return 0;
+}
\ No newline at end of file
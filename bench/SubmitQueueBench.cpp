@@ -0,0 +1,122 @@
+// ύ·΢׼ԱȾɵ mutex + std::queue + notify_one  BoundedQueue + Parker
+// ÷SubmitQueueBench [ÿύ]
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "../BoundedQueue.h"
+#include "../Parker.h"
+
+using Item = std::shared_ptr<int>;
+using Clock = std::chrono::steady_clock;
+
+// ʵ֣ÿύ notify_one
+class MutexSubmitPath {
+public:
+    void Submit(Item item) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            queue_.push(std::move(item));
+        }
+        cv_.notify_one();
+    }
+
+    void Consume(size_t total) {
+        size_t got = 0;
+        while (got < total) {
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_.wait(lk, [&]() { return !queue_.empty(); });
+            while (!queue_.empty()) {
+                queue_.pop();
+                ++got;
+            }
+        }
+    }
+
+private:
+    std::queue<Item> queue_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+};
+
+// ʵ֣ύֻʱŻ
+class LockFreeSubmitPath {
+public:
+    LockFreeSubmitPath() : queue_(4096) {}
+
+    void Submit(Item item) {
+        while (!queue_.TryPush(item)) {
+            std::this_thread::yield();
+        }
+        parker_.NotifyOne();
+    }
+
+    void Consume(size_t total) {
+        size_t got = 0;
+        Item item;
+        while (got < total) {
+            if (queue_.TryPop(item)) {
+                ++got;
+                continue;
+            }
+            uint64_t epoch = parker_.PrepareWait();
+            if (queue_.TryPop(item)) {
+                parker_.CancelWait();
+                ++got;
+                continue;
+            }
+            parker_.Wait(epoch);
+        }
+    }
+
+private:
+    BoundedQueue<Item> queue_;
+    Parker parker_;
+};
+
+template <class Path>
+static double Run(size_t producers, size_t opsPerProducer) {
+    Path path;
+    const size_t total = producers * opsPerProducer;
+    auto payload = std::make_shared<int>(42);
+    std::atomic<bool> go{ false };
+
+    std::thread consumer([&]() { path.Consume(total); });
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (size_t i = 0; i < opsPerProducer; ++i) {
+                path.Submit(payload);
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    consumer.join();
+    auto secs = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(total) / secs;
+}
+
+int main(int argc, char** argv) {
+    size_t ops = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200000;
+    const size_t producerCounts[] = { 1, 2, 4, 8, 16 };
+
+    std::printf("%-10s %18s %18s %8s\n", "producers", "mutex (sub/s)", "lock-free (sub/s)", "speedup");
+    for (size_t producers : producerCounts) {
+        double before = Run<MutexSubmitPath>(producers, ops);
+        double after = Run<LockFreeSubmitPath>(producers, ops);
+        std::printf("%-10zu %18.0f %18.0f %7.2fx\n", producers, before, after, after / before);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "TaskFactory.h"
 #include "WinUiObserver.h"
 #include "LogWriter.h"
+#include "TraceRecorder.h"
 
 // 控件ID
 constexpr int IDC_LISTBOX = 1001;
@@ -23,12 +24,14 @@ constexpr int IDC_BTN_STOP = 2005;
 constexpr int IDC_BTN_TEST = 2006;
 constexpr int IDC_BTN_TEST_SYSTEM = 2007;  // 测试调度器按钮
 
-constexpr UINT_PTR TIMER_REMINDER = 1;
+// TaskD：休息提醒由调度器的周期定时器触发，再转发到 UI 线程
+constexpr UINT WM_APP_REST_REMINDER = WM_APP + 2;
 
 // 全局控件句柄
 static HWND g_listBox = nullptr;
 static HWND g_resultText = nullptr;
 static std::atomic<bool> g_schedulerRunning = false;
+static TaskScheduler::TimerId g_reminderTimer = 0;
 
 // 辅助函数：向列表框添加文本
 static void ListBoxAddLine(const std::wstring& text) {
@@ -65,7 +68,7 @@ static void SetResultText(const std::wstring& s) {
 }
 
 // 格式化事件行
-static std::wstring FormatEventLine(const TaskEvent& e) {
+static std::wstring FormatEventLine(const TaskEvent& e, const std::string& message) {
     std::wstring type;
     switch (e.type) {
     case TaskEventType::Started: type = L"Started"; break;
@@ -77,11 +80,12 @@ static std::wstring FormatEventLine(const TaskEvent& e) {
     std::wstring line = L"[";
     line += type;
     line += L"] ";
-    line += ToWString(e.taskName);
+    line += ToWString(e.Name());
 
-    if (!e.message.empty()) {
+    // 消息文本已由批处理线程从消息池取出（见 WinUiObserver::OnEventBatch）
+    if (!message.empty()) {
         line += L" - ";
-        line += ToWString(e.message);
+        line += ToWString(message);
     }
     return line;
 }
@@ -132,19 +136,31 @@ static void StartScheduler(HWND hwnd) {
 
     // 创建日志目录
     std::filesystem::create_directories(std::filesystem::current_path() / "logs");
+    // 二进制结构化日志，用 tools/LogDecoder 查看（--json 输出 JSON）
+    LogWriterOptions logOptions;
+    logOptions.format = LogFileFormat::Binary;
+    logOptions.rotateBytes = 64ull * 1024 * 1024;
+    logOptions.rotatePeriod = std::chrono::hours(24);
     auto logger = std::make_shared<LogWriter>(
-        std::filesystem::current_path() / "logs" / "scheduler.log");
+        std::filesystem::current_path() / "logs" / "scheduler.slog", logOptions);
 
     // 添加UI观察者
     auto uiObs = std::make_shared<WinUiObserver>(hwnd);
     TaskScheduler::Instance().AddObserver(uiObs);
 
-    // 启动调度器
-    TaskScheduler::Instance().Start(logger);
+    // 设置环境变量 SCHEDULER_TRACE 时记录跟踪，停止调度器时写出 logs/trace.json
+    if (GetEnvironmentVariableW(L"SCHEDULER_TRACE", nullptr, 0) > 0) {
+        TraceRecorder::Start();
+    }
+
+    // 启动调度器：界面线程在 WndProc 里提交，队列满时拒绝而不是阻塞（被拒绝的任务会出现在列表里）
+    QueueOptions queue;
+    queue.policy = OverflowPolicy::Reject;
+    TaskScheduler::Instance().Start(logger, 0, queue);
     g_schedulerRunning = true;
 
     ListBoxAddLine(L"====== Scheduler Started ======");
-    ListBoxAddLine(L"Log: " + (std::filesystem::current_path() / "logs" / "scheduler.log").wstring());
+    ListBoxAddLine(L"Log: " + (std::filesystem::current_path() / "logs" / "scheduler.slog").wstring());
     ListBoxAddLine(L"TaskA: Backup Data folder to Backup folder");
     ListBoxAddLine(L"TaskB: Matrix multiplication (100x100)");
     ListBoxAddLine(L"TaskC: Get GitHub Zen -> zen.txt");
@@ -164,6 +180,13 @@ static void StopScheduler() {
     TaskScheduler::Instance().Stop();
     g_schedulerRunning = false;
     ListBoxAddLine(L"====== Scheduler Stopped ======");
+    if (TraceRecorder::Enabled()) {
+        TraceRecorder::Stop();
+        auto tracePath = std::filesystem::current_path() / "logs" / "trace.json";
+        if (TraceRecorder::WriteChromeJson(tracePath)) {
+            ListBoxAddLine(L"Trace: " + tracePath.wstring());
+        }
+    }
     ListBoxAddLine(L"");
 
     std::cout << "Scheduler stopped" << std::endl;
@@ -198,6 +221,26 @@ private:
     std::string name_;
 };
 
+// TaskD：只负责把提醒转发到 UI 线程，弹窗仍由窗口过程完成
+class RestReminderTask : public ITask {
+public:
+    explicit RestReminderTask(HWND hwnd) : hwnd_(hwnd) {}
+
+    std::string GetName() const override {
+        return "TaskD Rest Reminder";
+    }
+
+    std::string Execute(const CancellationTokenPtr&) override {
+        if (!PostMessageW(hwnd_, WM_APP_REST_REMINDER, 0, 0)) {
+            return "Reminder error: PostMessageW failed";
+        }
+        return "Reminder posted";
+    }
+
+private:
+    HWND hwnd_;
+};
+
 // 窗口过程
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
@@ -281,7 +324,8 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         StartScheduler(hwnd);
 
         // TaskD：每60秒弹出休息提醒
-        SetTimer(hwnd, TIMER_REMINDER, 60000, nullptr); // 60秒 = 60000毫秒
+        g_reminderTimer = TaskScheduler::Instance().ScheduleEvery(
+            std::chrono::seconds(60), std::make_shared<RestReminderTask>(hwnd));
         ListBoxAddLine(L"[TaskD] Rest reminder enabled: every 60 seconds");
 
         std::cout << "Window creation completed" << std::endl;
@@ -361,87 +405,102 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         }
         return 0;
     }
-    case WM_TIMER: {
-        if (wParam == TIMER_REMINDER) {
-            std::cout << "TaskD timer triggered" << std::endl;
-
-            // 先取消当前任务
-            TaskScheduler::Instance().CancelCurrent();
-
-            // 弹出休息提醒
-            int result = MessageBoxW(hwnd,
-                L"⏰ 该休息了！\n\n"
-                L"当前任务已被取消。\n"
-                L"起身活动，放松眼睛。\n\n"
-                L"点击确定继续工作。",
-                L"TaskD - 休息提醒",
-                MB_OKCANCEL | MB_ICONINFORMATION | MB_DEFBUTTON1);
-
-            if (result == IDOK) {
-                ListBoxAddLine(L"[TaskD] Reminder acknowledged. Ready for next task.");
-                std::cout << "TaskD: User clicked OK" << std::endl;
-            }
-            else {
-                ListBoxAddLine(L"[TaskD] User cancelled reminder.");
-                std::cout << "TaskD: User clicked Cancel" << std::endl;
-            }
+    case WM_APP_REST_REMINDER: {
+        std::cout << "TaskD timer triggered" << std::endl;
+
+        // 先取消当前任务
+        TaskScheduler::Instance().CancelCurrent();
+
+        // 弹出休息提醒
+        int result = MessageBoxW(hwnd,
+            L"⏰ 该休息了！\n\n"
+            L"当前任务已被取消。\n"
+            L"起身活动，放松眼睛。\n\n"
+            L"点击确定继续工作。",
+            L"TaskD - 休息提醒",
+            MB_OKCANCEL | MB_ICONINFORMATION | MB_DEFBUTTON1);
+
+        if (result == IDOK) {
+            ListBoxAddLine(L"[TaskD] Reminder acknowledged. Ready for next task.");
+            std::cout << "TaskD: User clicked OK" << std::endl;
+        }
+        else {
+            ListBoxAddLine(L"[TaskD] User cancelled reminder.");
+            std::cout << "TaskD: User clicked Cancel" << std::endl;
         }
         return 0;
     }
 
     case WM_APP_TASK_EVENT: {
-        std::cout << "WM_APP_TASK_EVENT received" << std::endl;
-
-        auto* payload = reinterpret_cast<UiEventPayload*>(lParam);
-        if (!payload) {
+        auto* batch = reinterpret_cast<UiEventBatch*>(lParam);
+        if (!batch) {
             std::cout << "WM_APP_TASK_EVENT: payload is null" << std::endl;
             return 0;
         }
 
-        const auto& e = payload->e;
-        std::cout << "Processing task event: " << e.taskName
-            << ", Type: " << static_cast<int>(e.type)
-            << ", Msg: " << e.message << std::endl;
-
-        // 添加到列表框
-        std::wstring eventLine = FormatEventLine(e);
-        ListBoxAddLine(eventLine);
-
-        // 更新结果文本
-        std::wstring resultText = L"结果：";
-        resultText += ToWString(e.taskName);
-        resultText += L" - ";
-
-        switch (e.type) {
-        case TaskEventType::Started:
-            resultText += L"开始执行";
-            break;
-        case TaskEventType::Succeeded:
-            resultText += L"✅ 成功： " + ToWString(e.message);
+        std::cout << "WM_APP_TASK_EVENT received: " << batch->events.size() << " events" << std::endl;
+
+        // 整批添加完再重绘列表框
+        bool backupDone = false;
+        if (g_listBox) {
+            SendMessageW(g_listBox, WM_SETREDRAW, FALSE, 0);
+            for (size_t i = 0; i < batch->events.size(); ++i) {
+                const auto& e = batch->events[i];
+                std::wstring eventLine = FormatEventLine(e, batch->messages[i]);
+                SendMessageW(g_listBox, LB_ADDSTRING, 0, (LPARAM)eventLine.c_str());
+                if (e.type == TaskEventType::Succeeded && e.Name() == "TaskA File Backup") {
+                    backupDone = true;
+                }
+            }
+            if (batch->dropped > 0) {
+                std::wstring droppedLine = L"[UI] " + std::to_wstring(batch->dropped) + L" events dropped";
+                SendMessageW(g_listBox, LB_ADDSTRING, 0, (LPARAM)droppedLine.c_str());
+            }
+            SendMessageW(g_listBox, LB_SETTOPINDEX,
+                SendMessageW(g_listBox, LB_GETCOUNT, 0, 0) - 1, 0);
+            SendMessageW(g_listBox, WM_SETREDRAW, TRUE, 0);
+            InvalidateRect(g_listBox, nullptr, TRUE);
+        }
 
-            // TaskA完成时弹出消息框
-            if (e.taskName == "TaskA File Backup") {
-                MessageBoxW(hwnd, L"✅ 文件备份成功完成！",
-                    L"TaskA - 备份完成", MB_OK | MB_ICONINFORMATION);
+        // 结果文本只显示本批最后一个事件
+        if (!batch->events.empty()) {
+            const auto& e = batch->events.back();
+            const std::wstring message = ToWString(batch->messages.back());
+            std::wstring resultText = L"结果：";
+            resultText += ToWString(e.Name());
+            resultText += L" - ";
+
+            switch (e.type) {
+            case TaskEventType::Started:
+                resultText += L"开始执行";
+                break;
+            case TaskEventType::Succeeded:
+                resultText += L"✅ 成功： " + message;
+                break;
+            case TaskEventType::Failed:
+                resultText += L"❌ 失败： " + message;
+                break;
+            case TaskEventType::Cancelled:
+                resultText += L"⏹️ 取消： " + message;
+                break;
             }
-            break;
-        case TaskEventType::Failed:
-            resultText += L"❌ 失败： " + ToWString(e.message);
-            break;
-        case TaskEventType::Cancelled:
-            resultText += L"⏹️ 取消： " + ToWString(e.message);
-            break;
+
+            SetResultText(resultText);
         }
 
-        SetResultText(resultText);
+        delete batch;
 
-        delete payload;
+        // TaskA完成时弹出消息框
+        if (backupDone) {
+            MessageBoxW(hwnd, L"✅ 文件备份成功完成！",
+                L"TaskA - 备份完成", MB_OK | MB_ICONINFORMATION);
+        }
         return 0;
     }
 
     case WM_CLOSE:
         std::cout << "WM_CLOSE: Closing window" << std::endl;
-        KillTimer(hwnd, TIMER_REMINDER);
+        TaskScheduler::Instance().CancelTimer(g_reminderTimer);
         StopScheduler();
         DestroyWindow(hwnd);
         return 0;
@@ -0,0 +1,244 @@
+// ƽṹ־빤ߣ LogWriter  LogFileFormat::Binary дļתı JSON
+// ÷LogDecoder <־ļ> [--json] [-o ļ]
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../StructuredLog.h"
+
+using namespace StructuredLog;
+
+struct DecoderState {
+    std::unordered_map<uint32_t, std::string> formats;
+    std::unordered_map<uint32_t, std::string> names;
+    int64_t timestampNs = 0;
+};
+
+enum class ParseResult { Ok, NeedMore, Corrupt };
+
+static void AppendTime(int64_t timestampNs, std::string& out) {
+    int64_t second = timestampNs / 1000000000;
+    if (timestampNs < 0 && second * 1000000000 != timestampNs) --second;
+    std::time_t t = static_cast<std::time_t>(second);
+    std::tm tm{};
+    localtime_s(&tm, &t);
+    char buf[24];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    out += buf;
+}
+
+static void AppendJsonString(std::string_view s, std::string& out) {
+    out += '"';
+    for (char c : s) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+            else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+static void AppendJsonArg(const LogArg& arg, const DecoderState& state, std::string& out) {
+    char buf[32];
+    switch (arg.type) {
+    case LogArgType::Int:
+        std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(arg.i));
+        out += buf;
+        break;
+    case LogArgType::UInt:
+        std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(arg.u));
+        out += buf;
+        break;
+    case LogArgType::Double:
+        std::snprintf(buf, sizeof(buf), "%.17g", arg.d);
+        out += buf;
+        break;
+    case LogArgType::String:
+        AppendJsonString(arg.s, out);
+        break;
+    case LogArgType::Name: {
+        auto it = state.names.find(static_cast<uint32_t>(arg.u));
+        AppendJsonString(it != state.names.end() ? std::string_view(it->second) : std::string_view(), out);
+        break;
+    }
+    }
+}
+
+//  in ͷһ¼Entry Ⱦ׷ӵ out
+static ParseResult ParseRecord(std::string_view& in, DecoderState& state, bool json,
+    std::vector<LogArg>& args, std::string& out) {
+    std::string_view rest = in;
+
+    // ļͷµһдỰ֮ǰĶʱ׼
+    if (rest.front() == kLogMagic[0]) {
+        if (rest.size() < sizeof(kLogMagic)) return ParseResult::NeedMore;
+        if (std::memcmp(rest.data(), kLogMagic, sizeof(kLogMagic)) != 0) return ParseResult::Corrupt;
+        state = DecoderState();
+        in.remove_prefix(sizeof(kLogMagic));
+        return ParseResult::Ok;
+    }
+
+    auto tag = static_cast<LogRecordTag>(rest.front());
+    rest.remove_prefix(1);
+    uint64_t id = 0, value = 0, length = 0;
+    switch (tag) {
+    case LogRecordTag::FormatDef:
+    case LogRecordTag::NameDef:
+        if (!GetVarint(rest, id) || !GetVarint(rest, length) || length > rest.size()) return ParseResult::NeedMore;
+        (tag == LogRecordTag::FormatDef ? state.formats : state.names)[static_cast<uint32_t>(id)]
+            .assign(rest.substr(0, static_cast<size_t>(length)));
+        rest.remove_prefix(static_cast<size_t>(length));
+        in = rest;
+        return ParseResult::Ok;
+    case LogRecordTag::Entry:
+        break;
+    default:
+        return ParseResult::Corrupt;
+    }
+
+    if (!GetVarint(rest, id) || !GetVarint(rest, value) || !GetVarint(rest, length) || length > rest.size()) {
+        return ParseResult::NeedMore;
+    }
+    std::string_view payload = rest.substr(0, static_cast<size_t>(length));
+    rest.remove_prefix(static_cast<size_t>(length));
+    in = rest;
+
+    state.timestampNs += UnZigZag(value);
+    auto fmt = state.formats.find(static_cast<uint32_t>(id));
+    std::string_view tmpl = fmt != state.formats.end() ? std::string_view(fmt->second) : std::string_view("{}");
+
+    // ʽ 0 Ǵı payload һ
+    if (id == static_cast<uint64_t>(LogFmt::Text)) {
+        args.clear();
+        LogArg text;
+        text.type = LogArgType::String;
+        text.s = payload;
+        args.push_back(text);
+    }
+    else if (!DecodeArgs(payload, args)) {
+        return ParseResult::Corrupt;
+    }
+
+    auto lookup = [&state](uint32_t nameId) -> std::string_view {
+        auto it = state.names.find(nameId);
+        return it != state.names.end() ? std::string_view(it->second) : std::string_view();
+    };
+
+    if (!json) {
+        out += '[';
+        AppendTime(state.timestampNs, out);
+        out += "] ";
+        Render(tmpl, args, lookup, out);
+        out += '\n';
+        return ParseResult::Ok;
+    }
+
+    std::string message;
+    Render(tmpl, args, lookup, message);
+    out += "{\"time\":\"";
+    AppendTime(state.timestampNs, out);
+    out += "\",\"ns\":";
+    out += std::to_string(state.timestampNs);
+    out += ",\"format\":";
+    out += std::to_string(id);
+    out += ",\"message\":";
+    AppendJsonString(message, out);
+    out += ",\"args\":[";
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (i > 0) out += ',';
+        AppendJsonArg(args[i], state, out);
+    }
+    out += "]}\n";
+    return ParseResult::Ok;
+}
+
+int main(int argc, char** argv) {
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) json = true;
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputPath = argv[++i];
+        else inputPath = argv[i];
+    }
+    if (!inputPath) {
+        std::fprintf(stderr, "Usage: LogDecoder <log file> [--json] [-o output]\n");
+        return 2;
+    }
+
+    std::ifstream in(inputPath, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "Cannot open %s\n", inputPath);
+        return 1;
+    }
+    std::ofstream file;
+    if (outputPath) {
+        file.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::fprintf(stderr, "Cannot create %s\n", outputPath);
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath ? static_cast<std::ostream&>(file) : std::cout;
+
+    char magic[sizeof(kLogMagic)] = {};
+    in.read(magic, sizeof(magic));
+    if (in.gcount() != sizeof(magic) || std::memcmp(magic, kLogMagic, sizeof(magic)) != 0) {
+        std::fprintf(stderr, "%s is not a binary scheduler log\n", inputPath);
+        return 1;
+    }
+
+    // ֿȡļ¼һƴϺٽ
+    DecoderState state;
+    std::vector<LogArg> args;
+    std::string buffer;
+    std::string text;
+    std::vector<char> chunk(1 << 20);
+    size_t records = 0;
+    bool eof = false;
+    while (!eof) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        size_t got = static_cast<size_t>(in.gcount());
+        eof = got < chunk.size();
+        buffer.append(chunk.data(), got);
+
+        std::string_view view(buffer);
+        while (!view.empty()) {
+            ParseResult r = ParseRecord(view, state, json, args, text);
+            if (r == ParseResult::NeedMore) break;
+            if (r == ParseResult::Corrupt) {
+                out << text;
+                std::fprintf(stderr, "Corrupt record after %zu records\n", records);
+                return 1;
+            }
+            ++records;
+        }
+        out << text;
+        text.clear();
+        buffer.erase(0, buffer.size() - view.size());
+    }
+
+    if (!buffer.empty()) {
+        // ̱ʱһ¼ֻдһ
+        std::fprintf(stderr, "Ignored %zu bytes of truncated record at end of file\n", buffer.size());
+    }
+    return 0;
+}
\ No newline at end of file